@@ -44,6 +44,16 @@ if(VCPKG_TARGET_IS_EMSCRIPTEN)
     )
 endif()
 
+# The instruction set level of the triplet selects fixed kernels instead of the build machine's.
+# With dynamic-arch, it is the baseline of the code which is shared by all kernels.
+if(VCPKG_TARGET_ISA_LEVEL STREQUAL "x86-64-v2")
+    list(APPEND OPTIONS -DTARGET=NEHALEM)
+elseif(VCPKG_TARGET_ISA_LEVEL STREQUAL "x86-64-v3")
+    list(APPEND OPTIONS -DTARGET=HASWELL)
+elseif(VCPKG_TARGET_ISA_LEVEL STREQUAL "x86-64-v4")
+    list(APPEND OPTIONS -DTARGET=SKYLAKEX)
+endif()
+
 vcpkg_cmake_configure(
     SOURCE_PATH "${SOURCE_PATH}"
     OPTIONS
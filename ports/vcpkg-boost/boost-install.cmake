@@ -1,5 +1,167 @@
 include_guard(GLOBAL)
 
+# The boost ports share their configured build trees when the environment variable
+# VCPKG_BOOST_BUILD_TREE_CACHE_DIR is set and passed through VCPKG_KEEP_ENV_VARS. It is not a
+# triplet variable, so that the machine-local path does not affect the ABI hashes.
+# The directory should be on the same volume as the buildtrees.
+# Each port starts from the CMake cache of the previous boost port of the triplet, reduced to the
+# toolchain detection, so that the compilers are detected once instead of once per port.
+# Every other cache entry, e.g. the results of find_package and of the configuration checks of a
+# library, is computed again, so the installed files do not depend on the ports built before.
+
+# Computes the key of the shared build trees for the toolchain of the current triplet.
+function(z_vcpkg_boost_build_tree_cache_key out_var)
+  set(key_material "")
+  foreach(var IN ITEMS
+    CMAKE_VERSION
+    VERSION
+    TARGET_TRIPLET
+    VCPKG_TARGET_ARCHITECTURE
+    VCPKG_CMAKE_SYSTEM_NAME
+    VCPKG_CMAKE_SYSTEM_VERSION
+    VCPKG_PLATFORM_TOOLSET
+    VCPKG_PLATFORM_TOOLSET_VERSION
+    VCPKG_LIBRARY_LINKAGE
+    VCPKG_CRT_LINKAGE
+    VCPKG_CHAINLOAD_TOOLCHAIN_FILE
+    VCPKG_C_FLAGS VCPKG_C_FLAGS_DEBUG VCPKG_C_FLAGS_RELEASE
+    VCPKG_CXX_FLAGS VCPKG_CXX_FLAGS_DEBUG VCPKG_CXX_FLAGS_RELEASE
+    VCPKG_LINKER_FLAGS VCPKG_LINKER_FLAGS_DEBUG VCPKG_LINKER_FLAGS_RELEASE
+    VCPKG_OSX_DEPLOYMENT_TARGET
+    VCPKG_OSX_SYSROOT
+    VCPKG_OSX_ARCHITECTURES
+    VCPKG_CMAKE_CONFIGURE_OPTIONS VCPKG_CMAKE_CONFIGURE_OPTIONS_DEBUG VCPKG_CMAKE_CONFIGURE_OPTIONS_RELEASE
+    _VCPKG_INSTALLED_DIR
+  )
+    string(APPEND key_material "${var}=${${var}}\n")
+  endforeach()
+  foreach(env_var IN ITEMS
+    PATH INCLUDE LIB LIBPATH
+    CC CXX ASM CFLAGS CXXFLAGS ASMFLAGS LDFLAGS
+    SDKROOT MACOSX_DEPLOYMENT_TARGET
+    VisualStudioVersion VCToolsVersion WindowsSdkDir WindowsSDKVersion VSCMD_ARG_TGT_ARCH
+  )
+    string(APPEND key_material "ENV{${env_var}}=$ENV{${env_var}}\n")
+  endforeach()
+  file(GLOB toolchain_files "${SCRIPTS}/toolchains/*.cmake")
+  list(SORT toolchain_files)
+  foreach(file IN LISTS CMAKE_TRIPLET_FILE VCPKG_CHAINLOAD_TOOLCHAIN_FILE toolchain_files)
+    if(EXISTS "${file}")
+      file(SHA256 "${file}" file_hash)
+      string(APPEND key_material "${file}=${file_hash}\n")
+    endif()
+  endforeach()
+  string(SHA256 key "${key_material}")
+  string(SUBSTRING "${key}" 0 16 key)
+  set("${out_var}" "${key}" PARENT_SCOPE)
+endfunction()
+
+# Computes the identity (path, size and timestamp) of the tools in the CMake cache of build_dir.
+function(z_vcpkg_boost_build_tree_tool_identity out_var build_dir)
+  set(identity "")
+  if(EXISTS "${build_dir}/CMakeCache.txt")
+    file(STRINGS "${build_dir}/CMakeCache.txt" tool_lines REGEX "^CMAKE_([A-Z_]+_COMPILER|AR|LINKER|RANLIB|MT|RC_COMPILER):[A-Z]+=")
+    foreach(line IN LISTS tool_lines)
+      string(REGEX REPLACE "^[^=]*=" "" tool "${line}")
+      if(IS_ABSOLUTE "${tool}" AND EXISTS "${tool}" AND NOT IS_DIRECTORY "${tool}")
+        file(REAL_PATH "${tool}" tool_real_path)
+        file(SIZE "${tool_real_path}" tool_size)
+        file(TIMESTAMP "${tool_real_path}" tool_timestamp "%Y-%m-%dT%H:%M:%S" UTC)
+        string(APPEND identity "${tool}|${tool_size}|${tool_timestamp}\n")
+      endif()
+    endforeach()
+  endif()
+  set("${out_var}" "${identity}" PARENT_SCOPE)
+endfunction()
+
+# Moves the shared build trees for the current triplet into the buildtrees of the port.
+# Entries are claimed by renaming them, so that concurrent builds never share a tree.
+# out_var is set to the directory which z_vcpkg_boost_build_tree_cache_store publishes.
+function(z_vcpkg_boost_build_tree_cache_restore out_var cache_dir)
+  z_vcpkg_boost_build_tree_cache_key(key)
+  set(entry "${cache_dir}/${key}")
+  set(claimed "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-build-tree-cache")
+  set("${out_var}" "${claimed}" PARENT_SCOPE)
+
+  file(REMOVE_RECURSE "${claimed}" "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-rel" "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-dbg")
+  file(MAKE_DIRECTORY "${cache_dir}")
+  set(rename_result 1)
+  if(EXISTS "${entry}")
+    file(RENAME "${entry}" "${claimed}" RESULT rename_result)
+  endif()
+  if(NOT rename_result STREQUAL "0")
+    file(MAKE_DIRECTORY "${claimed}")
+    return()
+  endif()
+
+  # Updated compilers invalidate the entry.
+  set(cached_identity "")
+  if(EXISTS "${claimed}/tool-identity.txt")
+    file(READ "${claimed}/tool-identity.txt" cached_identity)
+  endif()
+  z_vcpkg_boost_build_tree_tool_identity(current_identity "${claimed}/${TARGET_TRIPLET}-rel")
+  if(NOT "${current_identity}" STREQUAL "${cached_identity}")
+    message(STATUS "Ignoring the shared boost build tree for ${TARGET_TRIPLET}: the detected tools changed")
+    file(REMOVE_RECURSE "${claimed}")
+    file(MAKE_DIRECTORY "${claimed}")
+    return()
+  endif()
+
+  set(build_types rel)
+  if(NOT DEFINED VCPKG_BUILD_TYPE OR VCPKG_BUILD_TYPE STREQUAL "debug")
+    list(APPEND build_types dbg)
+  endif()
+  foreach(build_type IN LISTS build_types)
+    set(build_dir "${claimed}/${TARGET_TRIPLET}-${build_type}")
+    if(NOT EXISTS "${build_dir}/CMakeCache.txt")
+      continue()
+    endif()
+    # Keep the toolchain detection only. The source and build directories change with every port.
+    file(STRINGS "${build_dir}/CMakeCache.txt" cache_lines REGEX "^CMAKE_[A-Za-z0-9_]*:[A-Z]+=")
+    list(FILTER cache_lines EXCLUDE REGEX "^CMAKE_(HOME_DIRECTORY|CACHEFILE_DIR|INSTALL_PREFIX|PROJECT_[A-Z_]+):")
+    set(cache_contents "")
+    foreach(line IN LISTS cache_lines)
+      if(NOT line MATCHES "[[]" AND NOT line MATCHES "]")
+        string(APPEND cache_contents "${line}\n")
+      endif()
+    endforeach()
+    file(WRITE "${build_dir}/CMakeCache.txt" "${cache_contents}")
+    # The parallel configure step would consider the existing cache up to date.
+    file(REMOVE_RECURSE "${build_dir}/vcpkg-parallel-configure")
+    file(RENAME "${build_dir}" "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-${build_type}")
+  endforeach()
+  message(STATUS "Using the shared boost build tree ${key} for ${TARGET_TRIPLET}")
+endfunction()
+
+# Moves the build trees of the port back into claimed_dir and publishes it for the next port.
+# Only the CMake cache and the toolchain detection are kept; the objects of the port are not
+# needed by the next one.
+function(z_vcpkg_boost_build_tree_cache_store claimed_dir cache_dir)
+  foreach(build_type IN ITEMS rel dbg)
+    set(build_dir "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-${build_type}")
+    if(EXISTS "${build_dir}/CMakeCache.txt")
+      file(GLOB build_dir_entries LIST_DIRECTORIES true "${build_dir}/*")
+      list(REMOVE_ITEM build_dir_entries "${build_dir}/CMakeCache.txt" "${build_dir}/CMakeFiles")
+      file(GLOB cmake_files_entries LIST_DIRECTORIES true "${build_dir}/CMakeFiles/*")
+      list(REMOVE_ITEM cmake_files_entries "${build_dir}/CMakeFiles/${CMAKE_VERSION}")
+      if(NOT "${build_dir_entries};${cmake_files_entries}" STREQUAL ";")
+        file(REMOVE_RECURSE ${build_dir_entries} ${cmake_files_entries})
+      endif()
+      file(REMOVE_RECURSE "${claimed_dir}/${TARGET_TRIPLET}-${build_type}")
+      file(RENAME "${build_dir}" "${claimed_dir}/${TARGET_TRIPLET}-${build_type}")
+    endif()
+  endforeach()
+  z_vcpkg_boost_build_tree_tool_identity(identity "${claimed_dir}/${TARGET_TRIPLET}-rel")
+  file(WRITE "${claimed_dir}/tool-identity.txt" "${identity}")
+
+  z_vcpkg_boost_build_tree_cache_key(key)
+  # Renaming fails when a concurrent build published the key first, or across volumes.
+  file(RENAME "${claimed_dir}" "${cache_dir}/${key}" RESULT rename_result)
+  if(NOT rename_result STREQUAL "0")
+    file(REMOVE_RECURSE "${claimed_dir}")
+  endif()
+endfunction()
+
 function(boost_configure_and_install)
   cmake_parse_arguments(PARSE_ARGV 0 "arg" "" "SOURCE_PATH" "OPTIONS")
 
@@ -51,8 +213,16 @@ include(BoostRoot)\n"
     list(APPEND arg_OPTIONS -DBOOST_ENABLE_PYTHON=ON)
   endif()
 
+  set(build_tree_options "")
+  file(TO_CMAKE_PATH "$ENV{VCPKG_BOOST_BUILD_TREE_CACHE_DIR}" build_tree_cache_dir)
+  if(NOT build_tree_cache_dir STREQUAL "")
+    z_vcpkg_boost_build_tree_cache_restore(build_tree_cache_entry "${build_tree_cache_dir}")
+    set(build_tree_options Z_KEEP_BUILD_DIRECTORIES)
+  endif()
+
   vcpkg_cmake_configure(
     SOURCE_PATH "${arg_SOURCE_PATH}"
+    ${build_tree_options}
     OPTIONS
       -DBOOST_INCLUDE_LIBRARIES=${boost_lib_name}
       -DBOOST_RUNTIME_LINK=${VCPKG_CRT_LINKAGE}
@@ -63,6 +233,10 @@ include(BoostRoot)\n"
 
   vcpkg_cmake_install()
 
+  if(NOT build_tree_cache_dir STREQUAL "")
+    z_vcpkg_boost_build_tree_cache_store("${build_tree_cache_entry}" "${build_tree_cache_dir}")
+  endif()
+
   file(GLOB cmake_paths "${CURRENT_PACKAGES_DIR}/lib/cmake/*" LIST_DIRECTORIES true)
   file(GLOB cmake_files "${CURRENT_PACKAGES_DIR}/lib/cmake/*" LIST_DIRECTORIES false)
   list(REMOVE_ITEM cmake_paths "${cmake_files}" "${CURRENT_PACKAGES_DIR}/lib/cmake/boost_${boost_lib_name_config}-${SEMVER_VERSION}")
@@ -1,7 +1,10 @@
 include_guard(GLOBAL)
 
+set(Z_VCPKG_CMAKE_CONFIG_FIXUP_SCRIPT "${CMAKE_CURRENT_LIST_FILE}")
+
 function(vcpkg_cmake_config_fixup)
-    cmake_parse_arguments(PARSE_ARGV 0 "arg" "DO_NOT_DELETE_PARENT_CONFIG_PATH;NO_PREFIX_CORRECTION" "PACKAGE_NAME;CONFIG_PATH;TOOLS_PATH" "")
+    z_vcpkg_profile_begin(fixup vcpkg_cmake_config_fixup)
+    cmake_parse_arguments(PARSE_ARGV 0 "arg" "DO_NOT_DELETE_PARENT_CONFIG_PATH;NO_PREFIX_CORRECTION;CONSOLIDATE" "PACKAGE_NAME;CONFIG_PATH;TOOLS_PATH" "")
 
     if(DEFINED arg_UNPARSED_ARGUMENTS)
         message(FATAL_ERROR "vcpkg_cmake_config_fixup was passed extra arguments: ${arg_UNPARSED_ARGUMENTS}")
@@ -82,37 +85,30 @@ function(vcpkg_cmake_config_fixup)
         endif()
     endif()
 
+    # Each file is read and written once, with all the rewrites which apply to it.
     file(GLOB_RECURSE release_targets
         "${release_share}/*-release.cmake"
     )
-    foreach(release_target IN LISTS release_targets)
-        file(READ "${release_target}" contents)
-        string(REPLACE "${CURRENT_INSTALLED_DIR}" "\${_IMPORT_PREFIX}" contents "${contents}")
-        string(REGEX REPLACE "\\\${_IMPORT_PREFIX}/bin/([^ \"]+${EXECUTABLE_SUFFIX})" "\${_IMPORT_PREFIX}/${arg_TOOLS_PATH}/\\1" contents "${contents}")
-        file(WRITE "${release_target}" "${contents}")
-    endforeach()
-
+    set(debug_targets "")
+    set(debug_target_destinations "")
     if(NOT DEFINED VCPKG_BUILD_TYPE OR VCPKG_BUILD_TYPE STREQUAL "debug")
         file(GLOB_RECURSE debug_targets
             "${debug_share}/*-debug.cmake"
             )
         foreach(debug_target IN LISTS debug_targets)
             file(RELATIVE_PATH debug_target_rel "${debug_share}" "${debug_target}")
-
-            file(READ "${debug_target}" contents)
-            string(REPLACE "${CURRENT_INSTALLED_DIR}" "\${_IMPORT_PREFIX}" contents "${contents}")
-            string(REGEX REPLACE "\\\${_IMPORT_PREFIX}/bin/([^ \";]+${EXECUTABLE_SUFFIX})" "\${_IMPORT_PREFIX}/${arg_TOOLS_PATH}/\\1" contents "${contents}")
-            string(REPLACE "\${_IMPORT_PREFIX}/lib" "\${_IMPORT_PREFIX}/debug/lib" contents "${contents}")
-            string(REPLACE "\${_IMPORT_PREFIX}/bin" "\${_IMPORT_PREFIX}/debug/bin" contents "${contents}")
-            file(WRITE "${release_share}/${debug_target_rel}" "${contents}")
-
-            file(REMOVE "${debug_target}")
+            list(APPEND debug_target_destinations "${release_share}/${debug_target_rel}")
         endforeach()
     endif()
 
     #Fix ${_IMPORT_PREFIX} and absolute paths in cmake generated targets and configs;
     #Since those can be renamed we have to check in every *.cmake, but only once.
     file(GLOB_RECURSE main_cmakes "${release_share}/*.cmake")
+    foreach(debug_target_destination IN LISTS debug_target_destinations)
+        if(NOT EXISTS "${debug_target_destination}")
+            list(APPEND main_cmakes "${debug_target_destination}")
+        endif()
+    endforeach()
     if(NOT DEFINED Z_VCPKG_CMAKE_CONFIG_ALREADY_FIXED_UP)
         vcpkg_list(SET Z_VCPKG_CMAKE_CONFIG_ALREADY_FIXED_UP)
     endif()
@@ -122,8 +118,111 @@ function(vcpkg_cmake_config_fixup)
     vcpkg_list(APPEND Z_VCPKG_CMAKE_CONFIG_ALREADY_FIXED_UP ${main_cmakes})
     set(Z_VCPKG_CMAKE_CONFIG_ALREADY_FIXED_UP "${Z_VCPKG_CMAKE_CONFIG_ALREADY_FIXED_UP}" CACHE INTERNAL "")
 
+    set(job_sources ${release_targets} ${debug_targets})
+    set(job_destinations ${release_targets} ${debug_target_destinations})
+    set(job_kinds "")
+    foreach(release_target IN LISTS release_targets)
+        list(APPEND job_kinds "release")
+    endforeach()
+    foreach(debug_target IN LISTS debug_targets)
+        list(APPEND job_kinds "debug")
+    endforeach()
     foreach(main_cmake IN LISTS main_cmakes)
-        file(READ "${main_cmake}" contents)
+        if(NOT main_cmake IN_LIST job_destinations)
+            list(APPEND job_sources "${main_cmake}")
+            list(APPEND job_destinations "${main_cmake}")
+            list(APPEND job_kinds "")
+        endif()
+    endforeach()
+
+    set(jobs "")
+    foreach(source destination kind IN ZIP_LISTS job_sources job_destinations job_kinds)
+        set(fix_main OFF)
+        set(debug_cmake "")
+        if(destination IN_LIST main_cmakes)
+            set(fix_main ON)
+            # The debug import files are moved to the release directory, so they cannot be merged.
+            string(REPLACE "${release_share}/" "${debug_share}/" debug_cmake "${destination}")
+            if(debug_cmake IN_LIST debug_targets)
+                set(debug_cmake "")
+            endif()
+        endif()
+        string(APPEND jobs "z_vcpkg_cmake_config_fixup_file([==[${source}]==] [==[${destination}]==] \"${kind}\" ${fix_main} [==[${debug_cmake}]==])\n")
+    endforeach()
+
+    list(LENGTH job_sources job_count)
+    set(fixup_in_parallel OFF)
+    # Starting processes costs more than fixing up a few files.
+    if(NOT DEFINED Z_VCPKG_CMAKE_CONFIG_FIXUP_MIN_PARALLEL_FILES)
+        set(Z_VCPKG_CMAKE_CONFIG_FIXUP_MIN_PARALLEL_FILES 32)
+    endif()
+    if(NOT job_count LESS Z_VCPKG_CMAKE_CONFIG_FIXUP_MIN_PARALLEL_FILES AND VCPKG_CONCURRENCY GREATER "1")
+        z_vcpkg_execute_build_process_parallel_supported(fixup_in_parallel)
+    endif()
+    if(fixup_in_parallel)
+        z_vcpkg_cmake_config_fixup_parallel("${jobs}")
+    else()
+        cmake_language(EVAL CODE "${jobs}")
+    endif()
+    if(NOT debug_targets STREQUAL "")
+        file(REMOVE ${debug_targets})
+    endif()
+
+    # Triplets can enable this for all ports, and ports can opt out with set(VCPKG_CMAKE_CONFIG_CONSOLIDATE OFF).
+    if(arg_CONSOLIDATE OR VCPKG_CMAKE_CONFIG_CONSOLIDATE)
+        z_vcpkg_cmake_config_consolidate("${release_share}")
+    endif()
+
+    file(GLOB_RECURSE unused_files
+        "${debug_share}/*[Tt]argets.cmake"
+        "${debug_share}/*[Cc]onfig.cmake"
+        "${debug_share}/*[Cc]onfigVersion.cmake"
+        "${debug_share}/*[Cc]onfig-version.cmake"
+    )
+    foreach(unused_file IN LISTS unused_files)
+        file(REMOVE "${unused_file}")
+    endforeach()
+
+    # Remove /debug/<target_path>/ if it's empty.
+    file(GLOB_RECURSE remaining_files "${debug_share}/*")
+    if(remaining_files STREQUAL "")
+        file(REMOVE_RECURSE "${debug_share}")
+    endif()
+
+    # Remove /debug/share/ if it's empty.
+    file(GLOB_RECURSE remaining_files "${CURRENT_PACKAGES_DIR}/debug/share/*")
+    if(remaining_files STREQUAL "")
+        file(REMOVE_RECURSE "${CURRENT_PACKAGES_DIR}/debug/share")
+    endif()
+    z_vcpkg_profile_end(vcpkg_cmake_config_fixup)
+endfunction()
+
+# Applies the rewrites of vcpkg_cmake_config_fixup to source and writes the result to destination.
+# kind is "release" or "debug" for the import files of a configuration, which are relocated to the
+# tools path and to the debug directory. fix_main enables the corrections of all *.cmake files, which
+# merge the link libraries from debug_cmake. The options are taken from vcpkg_cmake_config_fixup.
+function(z_vcpkg_cmake_config_fixup_file source destination kind fix_main debug_cmake)
+    file(READ "${source}" contents)
+    set(original_contents "${contents}")
+
+    # The regular expressions are costly for large files, so they are only run when they can match.
+    if(kind STREQUAL "release")
+        string(REPLACE "${CURRENT_INSTALLED_DIR}" "\${_IMPORT_PREFIX}" contents "${contents}")
+        string(FIND "${contents}" "\${_IMPORT_PREFIX}/bin/" index)
+        if(NOT index EQUAL "-1")
+            string(REGEX REPLACE "\\\${_IMPORT_PREFIX}/bin/([^ \"]+${EXECUTABLE_SUFFIX})" "\${_IMPORT_PREFIX}/${arg_TOOLS_PATH}/\\1" contents "${contents}")
+        endif()
+    elseif(kind STREQUAL "debug")
+        string(REPLACE "${CURRENT_INSTALLED_DIR}" "\${_IMPORT_PREFIX}" contents "${contents}")
+        string(FIND "${contents}" "\${_IMPORT_PREFIX}/bin/" index)
+        if(NOT index EQUAL "-1")
+            string(REGEX REPLACE "\\\${_IMPORT_PREFIX}/bin/([^ \";]+${EXECUTABLE_SUFFIX})" "\${_IMPORT_PREFIX}/${arg_TOOLS_PATH}/\\1" contents "${contents}")
+        endif()
+        string(REPLACE "\${_IMPORT_PREFIX}/lib" "\${_IMPORT_PREFIX}/debug/lib" contents "${contents}")
+        string(REPLACE "\${_IMPORT_PREFIX}/bin" "\${_IMPORT_PREFIX}/debug/bin" contents "${contents}")
+    endif()
+
+    if(fix_main)
         # Note: I think the following comment is no longer true, since we now require the path to be `share/blah`
         # however, I don't know it for sure.
         # - nimazzuc
@@ -133,7 +232,8 @@ function(vcpkg_cmake_config_fixup)
         #is always at least (>=) 2, e.g. share/${PORT}. Currently the code assumes it is always 2 although
         #this requirement is only true for the *Config.cmake. The targets are not required to be in the same
         #folder as the *Config.cmake!
-        if(NOT arg_NO_PREFIX_CORRECTION)
+        string(FIND "${contents}" "get_filename_component(" index)
+        if(NOT arg_NO_PREFIX_CORRECTION AND NOT index EQUAL "-1")
             string(REGEX REPLACE
 [[get_filename_component\(_IMPORT_PREFIX "\${CMAKE_CURRENT_LIST_FILE}" PATH\)(
 get_filename_component\(_IMPORT_PREFIX "\${_IMPORT_PREFIX}" PATH\))*]]
@@ -152,7 +252,6 @@ get_filename_component(_IMPORT_PREFIX "${_IMPORT_PREFIX}" PATH)]]
         endif()
 
         # Merge release and debug configurations of target property INTERFACE_LINK_LIBRARIES.
-        string(REPLACE "${release_share}/" "${debug_share}/" debug_cmake "${main_cmake}")
         if(DEFINED VCPKG_BUILD_TYPE)
             # Skip. Warning: A release-only port in a dual-config installation
             # may pull release dependencies into the debug configuration.
@@ -160,8 +259,8 @@ get_filename_component(_IMPORT_PREFIX "${_IMPORT_PREFIX}" PATH)]]
             # Skip. No relevant properties.
         elseif(NOT contents MATCHES "# Generated CMake target import file\\.")
             # Skip. No safe assumptions about a matching debug import file.
-        elseif(NOT EXISTS "${debug_cmake}")
-            message(SEND_ERROR "Did not find a debug import file matching '${main_cmake}'")
+        elseif(debug_cmake STREQUAL "" OR NOT EXISTS "${debug_cmake}")
+            message(SEND_ERROR "Did not find a debug import file matching '${destination}'")
         else()
             file(READ "${debug_cmake}" debug_contents)
             set(remainder "${contents}")
@@ -193,36 +292,72 @@ get_filename_component(_IMPORT_PREFIX "${_IMPORT_PREFIX}" PATH)]]
         # If ${VCPKG_IMPORT_PREFIX} was actually used, inject a definition of it:
         string(FIND "${contents}" [[${VCPKG_IMPORT_PREFIX}]] index)
         if (NOT index STREQUAL "-1")
-            get_filename_component(main_cmake_dir "${main_cmake}" DIRECTORY)
+            get_filename_component(main_cmake_dir "${destination}" DIRECTORY)
             # Calculate relative to be a sequence of "../"
             file(RELATIVE_PATH relative "${main_cmake_dir}" "${cmake_current_packages_dir}")
             string(PREPEND contents "get_filename_component(VCPKG_IMPORT_PREFIX \"\${CMAKE_CURRENT_LIST_DIR}\/${relative}\" ABSOLUTE)\n")
         endif()
+    endif()
 
-        file(WRITE "${main_cmake}" "${contents}")
-    endforeach()
+    if(NOT source STREQUAL destination OR NOT contents STREQUAL original_contents)
+        file(WRITE "${destination}" "${contents}")
+    endif()
+endfunction()
 
-    file(GLOB_RECURSE unused_files
-        "${debug_share}/*[Tt]argets.cmake"
-        "${debug_share}/*[Cc]onfig.cmake"
-        "${debug_share}/*[Cc]onfigVersion.cmake"
-        "${debug_share}/*[Cc]onfig-version.cmake"
-    )
-    foreach(unused_file IN LISTS unused_files)
-        file(REMOVE "${unused_file}")
+# Runs the jobs of vcpkg_cmake_config_fixup, calls of z_vcpkg_cmake_config_fixup_file, in concurrent
+# CMake processes. The jobs are not repeatable, so failed processes only report their errors.
+function(z_vcpkg_cmake_config_fixup_parallel jobs)
+    string(REGEX MATCHALL "[^\n]+" jobs "${jobs}")
+    list(LENGTH jobs job_count)
+    set(chunk_count "${VCPKG_CONCURRENCY}")
+    if(job_count LESS chunk_count)
+        set(chunk_count "${job_count}")
+    endif()
+
+    # The processes use the policies of the port scripts.
+    set(script_prefix "cmake_minimum_required(VERSION ${CMAKE_MINIMUM_REQUIRED_VERSION})\ninclude([==[${Z_VCPKG_CMAKE_CONFIG_FIXUP_SCRIPT}]==])\n")
+    foreach(var IN ITEMS CURRENT_INSTALLED_DIR CURRENT_PACKAGES_DIR VCPKG_BUILD_TYPE arg_TOOLS_PATH arg_NO_PREFIX_CORRECTION EXECUTABLE_SUFFIX)
+        if(DEFINED "${var}")
+            string(APPEND script_prefix "set(${var} [==[${${var}}]==])\n")
+        endif()
     endforeach()
 
-    # Remove /debug/<target_path>/ if it's empty.
-    file(GLOB_RECURSE remaining_files "${debug_share}/*")
-    if(remaining_files STREQUAL "")
-        file(REMOVE_RECURSE "${debug_share}")
-    endif()
+    set(chunks_dir "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-config-fixup")
+    file(REMOVE_RECURSE "${chunks_dir}")
+    set(chunks "")
+    math(EXPR last_chunk "${chunk_count} - 1")
+    foreach(chunk RANGE "${last_chunk}")
+        set("fixup-${chunk}_script" "${script_prefix}")
+    endforeach()
+    set(chunk 0)
+    foreach(job IN LISTS jobs)
+        string(APPEND "fixup-${chunk}_script" "${job}\n")
+        math(EXPR chunk "(${chunk} + 1) % ${chunk_count}")
+    endforeach()
+    foreach(chunk RANGE "${last_chunk}")
+        set(name "fixup-${chunk}")
+        file(WRITE "${chunks_dir}/${name}.cmake" "${${name}_script}")
+        set("${name}_command" "${CMAKE_COMMAND}" -P "${chunks_dir}/${name}.cmake")
+        set("${name}_working_directory" "${chunks_dir}")
+        set("${name}_logname" "fixup-${TARGET_TRIPLET}-${chunk}")
+        list(APPEND chunks "${name}")
+    endforeach()
 
-    # Remove /debug/share/ if it's empty.
-    file(GLOB_RECURSE remaining_files "${CURRENT_PACKAGES_DIR}/debug/share/*")
-    if(remaining_files STREQUAL "")
-        file(REMOVE_RECURSE "${CURRENT_PACKAGES_DIR}/debug/share")
-    endif()
+    message(STATUS "Fixing up ${job_count} CMake files in ${chunk_count} processes")
+    z_vcpkg_execute_build_process_parallel(
+        PROCESSES ${chunks}
+        WORKING_DIRECTORY "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-config-fixup-parallel"
+        LOGNAME "fixup-${TARGET_TRIPLET}-parallel"
+        OUT_FAILED_VAR failed_chunks
+    )
+    foreach(name IN LISTS failed_chunks)
+        set(log "${CURRENT_BUILDTREES_DIR}/${${name}_logname}-err.log")
+        set(errors "")
+        if(EXISTS "${log}")
+            file(READ "${log}" errors)
+        endif()
+        message(SEND_ERROR "Fixing up CMake files failed in ${chunks_dir}/${name}.cmake:\n${errors}")
+    endforeach()
 endfunction()
 
 # Match a command from "<needle>" to ")\n". On match, returns the command and
@@ -276,3 +411,61 @@ function(z_vcpkg_cmake_config_fixup_merge out_var release_var debug_var)
     endforeach()
     set("${out_var}" "${merged_libs}" PARENT_SCOPE)
 endfunction()
+
+# Inlines the import files of each configuration into the CMake-generated target files in directory.
+# find_package() then reads one file per export set instead of globbing and including the import
+# files of all configurations; the imported targets are the same. Target files which do not match
+# the layout of install(EXPORT), or whose import files depend on their own location, are left as is.
+function(z_vcpkg_cmake_config_consolidate directory)
+    file(GLOB_RECURSE candidates "${directory}/*.cmake")
+    list(SORT candidates)
+    foreach(candidate IN LISTS candidates)
+        # The import files of earlier candidates are removed.
+        if(NOT EXISTS "${candidate}")
+            continue()
+        endif()
+        file(READ "${candidate}" contents)
+        if(NOT contents MATCHES "\n# Load information for each installed configuration[.]\n")
+            continue()
+        endif()
+        # CMake 3.24 and later
+        if(contents MATCHES "\nfile\\(GLOB _cmake_config_files \"\\\${CMAKE_CURRENT_LIST_DIR}/([^\"*/]+)-\\*\\.cmake\"\\)\n")
+            set(loader "file(GLOB _cmake_config_files \"\${CMAKE_CURRENT_LIST_DIR}/${CMAKE_MATCH_1}-*.cmake\")\nforeach(_cmake_config_file IN LISTS _cmake_config_files)\n  include(\"\${_cmake_config_file}\")\nendforeach()\nunset(_cmake_config_file)\nunset(_cmake_config_files)\n")
+        # Earlier versions, which set _DIR in the line before.
+        elseif(contents MATCHES "\nfile\\(GLOB CONFIG_FILES \"\\\${_DIR}/([^\"*/]+)-\\*\\.cmake\"\\)\n")
+            set(loader "file(GLOB CONFIG_FILES \"\${_DIR}/${CMAKE_MATCH_1}-*.cmake\")\nforeach(f \${CONFIG_FILES})\n  include(\${f})\nendforeach()\n")
+        else()
+            continue()
+        endif()
+        set(config_files_prefix "${CMAKE_MATCH_1}")
+        string(FIND "${contents}" "${loader}" loader_index)
+        if(loader_index EQUAL "-1")
+            continue()
+        endif()
+
+        get_filename_component(candidate_dir "${candidate}" DIRECTORY)
+        file(GLOB config_files "${candidate_dir}/${config_files_prefix}-*.cmake")
+        list(SORT config_files)
+        set(inlined "")
+        foreach(config_file IN LISTS config_files)
+            file(READ "${config_file}" config_contents)
+            if(NOT config_contents MATCHES "# Generated CMake target import file for configuration "
+                OR config_contents MATCHES "CMAKE_CURRENT_LIST_(FILE|LINE)|return[ \t]*\\(")
+                set(inlined "")
+                break()
+            endif()
+            get_filename_component(config_file_name "${config_file}" NAME)
+            if(NOT config_contents MATCHES "\n\$")
+                string(APPEND config_contents "\n")
+            endif()
+            string(APPEND inlined "# Inlined from ${config_file_name}\n${config_contents}")
+        endforeach()
+        if(inlined STREQUAL "")
+            continue()
+        endif()
+
+        string(REPLACE "${loader}" "${inlined}" contents "${contents}")
+        file(WRITE "${candidate}" "${contents}")
+        file(REMOVE ${config_files})
+    endforeach()
+endfunction()
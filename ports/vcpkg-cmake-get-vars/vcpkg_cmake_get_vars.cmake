@@ -17,14 +17,29 @@ function(vcpkg_cmake_get_vars out_file)
     if(NOT DEFINED CACHE{Z_VCPKG_CMAKE_GET_VARS_FILE${configuration_suffix}})
         set("Z_VCPKG_CMAKE_GET_VARS_FILE${configuration_suffix}" "${CURRENT_BUILDTREES_DIR}/cmake-get-vars${configuration_suffix}-${TARGET_TRIPLET}.cmake.log"
             CACHE PATH "The file to include to access the CMake variables from a generated project.")
-        vcpkg_cmake_configure(
+        set(output_files "")
+        if(NOT DEFINED VCPKG_BUILD_TYPE OR VCPKG_BUILD_TYPE STREQUAL "release")
+            list(APPEND output_files "${CURRENT_BUILDTREES_DIR}/cmake-get-vars${configuration_suffix}-${TARGET_TRIPLET}-rel.cmake.log")
+        endif()
+        if(NOT DEFINED VCPKG_BUILD_TYPE OR VCPKG_BUILD_TYPE STREQUAL "debug")
+            list(APPEND output_files "${CURRENT_BUILDTREES_DIR}/cmake-get-vars${configuration_suffix}-${TARGET_TRIPLET}-dbg.cmake.log")
+        endif()
+        z_vcpkg_cmake_get_vars_cache_key(cache_key
             SOURCE_PATH "${Z_VCPKG_CMAKE_GET_VARS_CURRENT_LIST_DIR}/cmake_get_vars"
-            OPTIONS "-DVCPKG_LANGUAGES=${languages}"
-            OPTIONS_DEBUG "-DVCPKG_OUTPUT_FILE:PATH=${CURRENT_BUILDTREES_DIR}/cmake-get-vars${configuration_suffix}-${TARGET_TRIPLET}-dbg.cmake.log"
-            OPTIONS_RELEASE "-DVCPKG_OUTPUT_FILE:PATH=${CURRENT_BUILDTREES_DIR}/cmake-get-vars${configuration_suffix}-${TARGET_TRIPLET}-rel.cmake.log"
-            LOGFILE_BASE cmake-get-vars${configuration_suffix}-${TARGET_TRIPLET}
-            Z_CMAKE_GET_VARS_USAGE # be quiet, don't set variables...
+            LANGUAGES ${languages}
         )
+        z_vcpkg_cmake_get_vars_cache_restore(KEY "${cache_key}" FILES ${output_files} OUT_HIT_VAR cache_hit)
+        if(NOT cache_hit)
+            vcpkg_cmake_configure(
+                SOURCE_PATH "${Z_VCPKG_CMAKE_GET_VARS_CURRENT_LIST_DIR}/cmake_get_vars"
+                OPTIONS "-DVCPKG_LANGUAGES=${languages}"
+                OPTIONS_DEBUG "-DVCPKG_OUTPUT_FILE:PATH=${CURRENT_BUILDTREES_DIR}/cmake-get-vars${configuration_suffix}-${TARGET_TRIPLET}-dbg.cmake.log"
+                OPTIONS_RELEASE "-DVCPKG_OUTPUT_FILE:PATH=${CURRENT_BUILDTREES_DIR}/cmake-get-vars${configuration_suffix}-${TARGET_TRIPLET}-rel.cmake.log"
+                LOGFILE_BASE cmake-get-vars${configuration_suffix}-${TARGET_TRIPLET}
+                Z_CMAKE_GET_VARS_USAGE # be quiet, don't set variables...
+            )
+            z_vcpkg_cmake_get_vars_cache_store(KEY "${cache_key}" FILES ${output_files})
+        endif()
         configure_file("${CMAKE_CURRENT_FUNCTION_LIST_DIR}/cmake-get-vars.cmake.in" "${Z_VCPKG_CMAKE_GET_VARS_FILE${configuration_suffix}}" @ONLY)
     endif()
 
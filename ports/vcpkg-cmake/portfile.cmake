@@ -7,6 +7,7 @@ file(INSTALL
     "${CMAKE_CURRENT_LIST_DIR}/vcpkg_cmake_configure.cmake"
     "${CMAKE_CURRENT_LIST_DIR}/vcpkg_cmake_build.cmake"
     "${CMAKE_CURRENT_LIST_DIR}/vcpkg_cmake_install.cmake"
+    "${CMAKE_CURRENT_LIST_DIR}/z_vcpkg_cmake_install_script.cmake"
     "${CMAKE_CURRENT_LIST_DIR}/vcpkg-port-config.cmake"
     DESTINATION "${CURRENT_PACKAGES_DIR}/share/${PORT}")
 
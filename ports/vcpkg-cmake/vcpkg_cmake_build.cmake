@@ -1,6 +1,7 @@
 include_guard(GLOBAL)
 
 function(vcpkg_cmake_build)
+    z_vcpkg_profile_begin(build vcpkg_cmake_build)
     cmake_parse_arguments(PARSE_ARGV 0 "arg" "DISABLE_PARALLEL;ADD_BIN_TO_PATH" "TARGET;LOGFILE_BASE" "")
 
     if(DEFINED arg_UNPARSED_ARGUMENTS)
@@ -41,7 +42,20 @@ function(vcpkg_cmake_build)
         vcpkg_list(SET target_param "--target" "${arg_TARGET}")
     endif()
 
-    foreach(build_type IN ITEMS debug release)
+    set(parallel_options "")
+    foreach(option IN ITEMS DISABLE_PARALLEL ADD_BIN_TO_PATH)
+        if(arg_${option})
+            list(APPEND parallel_options "${option}")
+        endif()
+    endforeach()
+    z_vcpkg_cmake_build_configs_in_parallel(build_types
+        LOGFILE_BASE "${arg_LOGFILE_BASE}"
+        ${parallel_options}
+        TARGET_ARGS ${target_param}
+        BUILD_TOOL_ARGS ${build_param}
+    )
+
+    foreach(build_type IN LISTS build_types)
         if(NOT DEFINED VCPKG_BUILD_TYPE OR "${VCPKG_BUILD_TYPE}" STREQUAL "${build_type}")
             if("${build_type}" STREQUAL "debug")
                 set(short_build_type "dbg")
@@ -88,4 +102,5 @@ function(vcpkg_cmake_build)
             endif()
         endif()
     endforeach()
+    z_vcpkg_profile_end(vcpkg_cmake_build)
 endfunction()
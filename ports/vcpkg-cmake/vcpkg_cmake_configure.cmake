@@ -9,8 +9,9 @@ macro(z_vcpkg_cmake_configure_both_set_or_unset var1 var2)
 endmacro()
 
 function(vcpkg_cmake_configure)
+    z_vcpkg_profile_begin(configure vcpkg_cmake_configure)
     cmake_parse_arguments(PARSE_ARGV 0 "arg"
-        "PREFER_NINJA;DISABLE_PARALLEL_CONFIGURE;WINDOWS_USE_MSBUILD;NO_CHARSET_FLAG;Z_CMAKE_GET_VARS_USAGE"
+        "PREFER_NINJA;DISABLE_PARALLEL_CONFIGURE;WINDOWS_USE_MSBUILD;NO_CHARSET_FLAG;Z_CMAKE_GET_VARS_USAGE;Z_KEEP_BUILD_DIRECTORIES"
         "SOURCE_PATH;GENERATOR;LOGFILE_BASE"
         "OPTIONS;OPTIONS_DEBUG;OPTIONS_RELEASE;MAYBE_UNUSED_VARIABLES"
     )
@@ -115,6 +116,18 @@ function(vcpkg_cmake_configure)
     if(generator STREQUAL "Ninja")
         vcpkg_find_acquire_program(NINJA)
         vcpkg_list(APPEND arg_OPTIONS "-DCMAKE_MAKE_PROGRAM=${NINJA}")
+        if(DEFINED VCPKG_LINK_CONCURRENCY)
+            # Cap the number of concurrent link jobs, unless the port defines its own job pools.
+            set(port_job_pools OFF)
+            foreach(option IN LISTS arg_OPTIONS arg_OPTIONS_RELEASE arg_OPTIONS_DEBUG)
+                if(option MATCHES "^-DCMAKE_JOB_POOL")
+                    set(port_job_pools ON)
+                endif()
+            endforeach()
+            if(NOT port_job_pools)
+                vcpkg_list(APPEND arg_OPTIONS "-DCMAKE_JOB_POOLS=vcpkg_link=${VCPKG_LINK_CONCURRENCY}" "-DCMAKE_JOB_POOL_LINK=vcpkg_link")
+            endif()
+        endif()
         # If we use Ninja, it must be on PATH for CMake's ExternalProject,
         # cf. https://gitlab.kitware.com/cmake/cmake/-/issues/23355.
         get_filename_component(ninja_path "${NINJA}" DIRECTORY)
@@ -128,9 +141,12 @@ function(vcpkg_cmake_configure)
 
     set(build_dir_release "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-rel")
     set(build_dir_debug "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-dbg")
-    file(REMOVE_RECURSE
-        "${build_dir_release}"
-        "${build_dir_debug}")
+    # Callers restoring build directories of an earlier build are responsible for their cache.
+    if(NOT arg_Z_KEEP_BUILD_DIRECTORIES)
+        file(REMOVE_RECURSE
+            "${build_dir_release}"
+            "${build_dir_debug}")
+    endif()
     file(MAKE_DIRECTORY "${build_dir_release}")
     if(NOT DEFINED VCPKG_BUILD_TYPE OR VCPKG_BUILD_TYPE STREQUAL "debug")
         file(MAKE_DIRECTORY "${build_dir_debug}")
@@ -207,6 +223,19 @@ function(vcpkg_cmake_configure)
         "-D_VCPKG_INSTALLED_DIR=${_VCPKG_INSTALLED_DIR}"
         "-DVCPKG_MANIFEST_INSTALL=OFF"
     )
+    if(DEFINED VCPKG_TARGET_ISA_LEVEL)
+        vcpkg_list(APPEND arg_OPTIONS "-DVCPKG_TARGET_ISA_LEVEL=${VCPKG_TARGET_ISA_LEVEL}")
+    endif()
+    if(DEFINED VCPKG_ENABLE_LTO)
+        vcpkg_list(APPEND arg_OPTIONS "-DVCPKG_ENABLE_LTO=${VCPKG_ENABLE_LTO}")
+    endif()
+    if(DEFINED VCPKG_LTO_CACHE_DIR)
+        vcpkg_list(APPEND arg_OPTIONS "-DVCPKG_LTO_CACHE_DIR=${VCPKG_LTO_CACHE_DIR}")
+    endif()
+    if(DEFINED VCPKG_COMPILER_LAUNCHER)
+        list(JOIN VCPKG_COMPILER_LAUNCHER "\;" compiler_launcher_string)
+        vcpkg_list(APPEND arg_OPTIONS "-DVCPKG_COMPILER_LAUNCHER=${compiler_launcher_string}")
+    endif()
 
     # Sets configuration variables for macOS builds
     foreach(config_var IN ITEMS INSTALL_NAME_DIR OSX_DEPLOYMENT_TARGET OSX_SYSROOT OSX_ARCHITECTURES)
@@ -350,4 +379,5 @@ If these options should still be passed for whatever reason, please use the `MAY
     if(NOT arg_Z_CMAKE_GET_VARS_USAGE)
         set(Z_VCPKG_CMAKE_GENERATOR "${generator}" CACHE INTERNAL "The generator which was used to configure CMake.")
     endif()
+    z_vcpkg_profile_end(vcpkg_cmake_configure)
 endfunction()
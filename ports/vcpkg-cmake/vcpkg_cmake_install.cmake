@@ -1,7 +1,10 @@
 include_guard(GLOBAL)
 
+set(Z_VCPKG_CMAKE_INSTALL_SCRIPT "${CMAKE_CURRENT_LIST_DIR}/z_vcpkg_cmake_install_script.cmake")
+
 function(vcpkg_cmake_install)
-    cmake_parse_arguments(PARSE_ARGV 0 "arg" "DISABLE_PARALLEL;ADD_BIN_TO_PATH" "" "")
+    z_vcpkg_profile_begin(install vcpkg_cmake_install)
+    cmake_parse_arguments(PARSE_ARGV 0 "arg" "DISABLE_PARALLEL;ADD_BIN_TO_PATH;SKIP_DEBUG_HEADERS" "" "")
     if(DEFINED arg_UNPARSED_ARGUMENTS)
         message(FATAL_ERROR "vcpkg_cmake_install was passed extra arguments: ${arg_UNPARSED_ARGUMENTS}")
     endif()
@@ -13,9 +16,81 @@ function(vcpkg_cmake_install)
         endif()
     endforeach()
 
+    # VCPKG_CMAKE_INSTALL_LINK_MODE selects how installed files are created from the build and source trees.
+    if(NOT "${VCPKG_CMAKE_INSTALL_LINK_MODE}" MATCHES "^(|copy|reflink)$")
+        message(FATAL_ERROR "VCPKG_CMAKE_INSTALL_LINK_MODE must be copy or reflink, not ${VCPKG_CMAKE_INSTALL_LINK_MODE}")
+    endif()
+    set(link_mode "${VCPKG_CMAKE_INSTALL_LINK_MODE}")
+    if(link_mode STREQUAL "copy")
+        set(link_mode "")
+    endif()
+    # SKIP_DEBUG_HEADERS marks the headers of both configurations as identical, so they are installed once.
+    set(skip_debug_headers OFF)
+    if(arg_SKIP_DEBUG_HEADERS AND NOT DEFINED VCPKG_BUILD_TYPE)
+        set(skip_debug_headers ON)
+    endif()
+
+    if(NOT "${Z_VCPKG_CMAKE_GENERATOR}" STREQUAL "Ninja" OR (link_mode STREQUAL "" AND NOT skip_debug_headers))
+        vcpkg_cmake_build(
+            ${args}
+            LOGFILE_BASE install
+            TARGET install
+        )
+        if(skip_debug_headers)
+            file(REMOVE_RECURSE "${CURRENT_PACKAGES_DIR}/debug/include")
+        endif()
+        z_vcpkg_profile_end(vcpkg_cmake_install)
+        return()
+    endif()
+
+    # The install target of Ninja builds all and then runs cmake_install.cmake, which is run directly here.
     vcpkg_cmake_build(
         ${args}
         LOGFILE_BASE install
-        TARGET install
     )
+    foreach(build_type IN ITEMS debug release)
+        if(DEFINED VCPKG_BUILD_TYPE AND NOT "${VCPKG_BUILD_TYPE}" STREQUAL "${build_type}")
+            continue()
+        endif()
+        if("${build_type}" STREQUAL "debug")
+            set(short_build_type "dbg")
+            set(config "Debug")
+        else()
+            set(short_build_type "rel")
+            set(config "Release")
+        endif()
+        set(build_dir "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-${short_build_type}")
+
+        set(install_options "")
+        if(skip_debug_headers AND "${build_type}" STREQUAL "debug")
+            list(APPEND install_options "-DZ_VCPKG_INSTALL_SKIP_DIR=${CURRENT_PACKAGES_DIR}/debug/include")
+        endif()
+
+        if(arg_ADD_BIN_TO_PATH)
+            vcpkg_backup_env_variables(VARS PATH)
+            if("${build_type}" STREQUAL "debug")
+                vcpkg_add_to_path(PREPEND "${CURRENT_INSTALLED_DIR}/debug/bin")
+            else()
+                vcpkg_add_to_path(PREPEND "${CURRENT_INSTALLED_DIR}/bin")
+            endif()
+        endif()
+
+        message(STATUS "Installing ${TARGET_TRIPLET}-${short_build_type}")
+        vcpkg_execute_required_process(
+            COMMAND
+                "${CMAKE_COMMAND}"
+                "-DCMAKE_INSTALL_CONFIG_NAME=${config}"
+                "-DZ_VCPKG_INSTALL_SCRIPT=${build_dir}/cmake_install.cmake"
+                "-DZ_VCPKG_INSTALL_LINK_MODE=${link_mode}"
+                ${install_options}
+                -P "${Z_VCPKG_CMAKE_INSTALL_SCRIPT}"
+            WORKING_DIRECTORY "${build_dir}"
+            LOGNAME "install-files-${TARGET_TRIPLET}-${short_build_type}"
+        )
+
+        if(arg_ADD_BIN_TO_PATH)
+            vcpkg_restore_env_variables(VARS PATH)
+        endif()
+    endforeach()
+    z_vcpkg_profile_end(vcpkg_cmake_install)
 endfunction()
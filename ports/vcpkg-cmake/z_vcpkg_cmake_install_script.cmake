@@ -0,0 +1,158 @@
+# Runs the cmake_install.cmake script of a Ninja build tree for vcpkg_cmake_install.
+#
+# Usage: cmake -DCMAKE_INSTALL_CONFIG_NAME=<config> -DZ_VCPKG_INSTALL_SCRIPT=<build tree>/cmake_install.cmake
+#            [-DZ_VCPKG_INSTALL_LINK_MODE=reflink] [-DZ_VCPKG_INSTALL_SKIP_DIR=<dir>]
+#            -P z_vcpkg_cmake_install_script.cmake
+#
+# Plain files and directories are cloned (reflink) instead of copied when Z_VCPKG_INSTALL_LINK_MODE
+# is set. Hard links are not offered: portfiles edit installed files in place, e.g. through
+# vcpkg_replace_string, which would reach the build and source trees.
+# Everything installed below Z_VCPKG_INSTALL_SKIP_DIR is skipped.
+# Installations which need more than a plain copy, e.g. with permissions, renames, patterns or
+# RPATH changes, are left to file(INSTALL).
+
+if(NOT DEFINED Z_VCPKG_INSTALL_LINK_MODE)
+    set(Z_VCPKG_INSTALL_LINK_MODE "")
+endif()
+set_property(GLOBAL PROPERTY Z_VCPKG_INSTALL_REFLINK_SUPPORTED ON)
+
+# Clones the files in ARGN into destination with cp. Sets out_var to whether all files were cloned.
+function(z_vcpkg_install_reflink out_var destination)
+    set("${out_var}" OFF PARENT_SCOPE)
+    get_property(reflink_supported GLOBAL PROPERTY Z_VCPKG_INSTALL_REFLINK_SUPPORTED)
+    if(NOT reflink_supported OR NOT (CMAKE_HOST_SYSTEM_NAME STREQUAL "Linux" OR CMAKE_HOST_APPLE))
+        return()
+    endif()
+    # Keep the command lines short.
+    set(batch "")
+    set(args ${ARGN} "")
+    foreach(item IN LISTS args)
+        if(NOT item STREQUAL "")
+            list(APPEND batch "${item}")
+            list(LENGTH batch batch_size)
+            if(batch_size LESS "200")
+                continue()
+            endif()
+        endif()
+        if(batch STREQUAL "")
+            continue()
+        endif()
+        if(CMAKE_HOST_APPLE)
+            set(copy_command cp -c -R -f ${batch} "${destination}/")
+        else()
+            set(copy_command cp -R -f --reflink=always --no-dereference -t "${destination}" ${batch})
+        endif()
+        execute_process(COMMAND ${copy_command} RESULT_VARIABLE copy_result OUTPUT_QUIET ERROR_QUIET)
+        if(NOT copy_result STREQUAL "0")
+            # Typically the file system does not support cloning, or the source is on another file system.
+            set_property(GLOBAL PROPERTY Z_VCPKG_INSTALL_REFLINK_SUPPORTED OFF)
+            return()
+        endif()
+        set(batch "")
+    endforeach()
+    set("${out_var}" ON PARENT_SCOPE)
+endfunction()
+
+# Installs the sources of a file(INSTALL) call of TYPE FILE or DIRECTORY without further options.
+# Sets out_var to the installed files, or to NOTFOUND when file(INSTALL) must do the work.
+function(z_vcpkg_install_link out_var destination type)
+    set("${out_var}" NOTFOUND PARENT_SCOPE)
+    set(links "")
+    set(clone_sources "")
+    foreach(source IN LISTS ARGN)
+        if(NOT IS_ABSOLUTE "${source}" OR IS_SYMLINK "${source}")
+            return()
+        endif()
+        if(type STREQUAL "FILE")
+            if(IS_DIRECTORY "${source}")
+                return()
+            endif()
+            cmake_path(GET source FILENAME name)
+            list(APPEND links "${destination}/${name}")
+            list(APPEND clone_sources "${source}")
+            continue()
+        endif()
+        if(NOT IS_DIRECTORY "${source}")
+            return()
+        endif()
+        # A trailing slash installs the contents of the directory.
+        if(source MATCHES "/$")
+            string(REGEX REPLACE "/+$" "" source "${source}")
+            set(target "${destination}")
+            _file(GLOB clone_items LIST_DIRECTORIES true "${source}/*")
+            list(APPEND clone_sources ${clone_items})
+        else()
+            cmake_path(GET source FILENAME name)
+            set(target "${destination}/${name}")
+            list(APPEND clone_sources "${source}")
+        endif()
+        _file(GLOB_RECURSE items LIST_DIRECTORIES true "${source}/*")
+        foreach(item IN LISTS items)
+            if(IS_SYMLINK "${item}")
+                return()
+            endif()
+            if(NOT IS_DIRECTORY "${item}")
+                cmake_path(RELATIVE_PATH item BASE_DIRECTORY "${source}" OUTPUT_VARIABLE relative_item)
+                list(APPEND links "${target}/${relative_item}")
+            endif()
+        endforeach()
+    endforeach()
+
+    _file(MAKE_DIRECTORY "${destination}")
+    set(linked OFF)
+    if(Z_VCPKG_INSTALL_LINK_MODE STREQUAL "reflink")
+        z_vcpkg_install_reflink(linked "${destination}" ${clone_sources})
+    endif()
+    if(NOT linked)
+        return()
+    endif()
+    # file(INSTALL) gives the same permissions to all files.
+    if(NOT links STREQUAL "")
+        _file(CHMOD ${links} FILE_PERMISSIONS OWNER_READ OWNER_WRITE GROUP_READ WORLD_READ)
+    endif()
+
+    list(LENGTH links link_count)
+    message(STATUS "Installing (${Z_VCPKG_INSTALL_LINK_MODE}): ${link_count} files to ${destination}")
+    set("${out_var}" "${links}" PARENT_SCOPE)
+endfunction()
+
+function(file)
+    if(ARGV0 STREQUAL "INSTALL")
+        cmake_parse_arguments(PARSE_ARGV 1 "z_vcpkg_arg" "OPTIONAL;MESSAGE_ALWAYS;MESSAGE_LAZY;MESSAGE_NEVER" "DESTINATION;TYPE" "FILES")
+        if(NOT "${Z_VCPKG_INSTALL_SKIP_DIR}" STREQUAL "")
+            cmake_path(IS_PREFIX Z_VCPKG_INSTALL_SKIP_DIR "${z_vcpkg_arg_DESTINATION}" NORMALIZE z_vcpkg_skip)
+            if(z_vcpkg_skip)
+                message(STATUS "Skipping: ${z_vcpkg_arg_DESTINATION}")
+                return()
+            endif()
+        endif()
+
+        set(z_vcpkg_installed NOTFOUND)
+        if(NOT Z_VCPKG_INSTALL_LINK_MODE STREQUAL "" AND NOT DEFINED z_vcpkg_arg_UNPARSED_ARGUMENTS
+            AND NOT z_vcpkg_arg_OPTIONAL AND NOT DEFINED ENV{DESTDIR}
+            AND z_vcpkg_arg_TYPE MATCHES "^(FILE|DIRECTORY)$" AND IS_ABSOLUTE "${z_vcpkg_arg_DESTINATION}")
+            z_vcpkg_install_link(z_vcpkg_installed "${z_vcpkg_arg_DESTINATION}" "${z_vcpkg_arg_TYPE}" ${z_vcpkg_arg_FILES})
+        endif()
+        if(z_vcpkg_installed)
+            list(APPEND CMAKE_INSTALL_MANIFEST_FILES ${z_vcpkg_installed})
+            set(CMAKE_INSTALL_MANIFEST_FILES "${CMAKE_INSTALL_MANIFEST_FILES}" PARENT_SCOPE)
+            return()
+        endif()
+    endif()
+
+    # Forward the arguments unchanged, including empty ones and ones containing semicolons.
+    set(z_vcpkg_code "_file(")
+    math(EXPR z_vcpkg_last "${ARGC} - 1")
+    foreach(z_vcpkg_index RANGE "${z_vcpkg_last}")
+        string(APPEND z_vcpkg_code " [==[${ARGV${z_vcpkg_index}}]==]")
+    endforeach()
+    cmake_language(EVAL CODE "${z_vcpkg_code})")
+    # Some subcommands set variables, e.g. file(DIFFERENT) in the scripts of install(EXPORT).
+    foreach(z_vcpkg_var IN LISTS ARGV ITEMS CMAKE_INSTALL_MANIFEST_FILES)
+        if(z_vcpkg_var MATCHES "^[A-Za-z_][A-Za-z0-9_]*$" AND DEFINED "${z_vcpkg_var}")
+            set("${z_vcpkg_var}" "${${z_vcpkg_var}}" PARENT_SCOPE)
+        endif()
+    endforeach()
+endfunction()
+
+include("${Z_VCPKG_INSTALL_SCRIPT}")
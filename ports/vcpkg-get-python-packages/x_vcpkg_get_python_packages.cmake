@@ -1,5 +1,81 @@
 include_guard(GLOBAL)
 
+# Virtual environments are cached in VCPKG_PYTHON_VENV_CACHE_DIR when it is set, e.g. in the triplet file.
+# Every port gets its own copy, so packages installed later by the portfile do not change the cache.
+# Packages are taken only from the directory VCPKG_PYTHON_WHEELHOUSE when it is set, which allows offline builds.
+
+# Computes the name of the cached virtual environment for the interpreter and the requested packages.
+# The full key, with the whole package list, is stored in OUT_KEY_MATERIAL and checked on every use.
+function(z_vcpkg_get_python_packages_venv_key out_var)
+    cmake_parse_arguments(PARSE_ARGV 1 arg "" "PYTHON_EXECUTABLE;PYTHON_VERSION;REQUIREMENTS_FILE;OUT_KEY_MATERIAL" "PACKAGES")
+
+    file(REAL_PATH "${arg_PYTHON_EXECUTABLE}" python_real_path)
+    file(SIZE "${python_real_path}" python_size)
+    file(TIMESTAMP "${python_real_path}" python_timestamp "%Y-%m-%dT%H:%M:%S" UTC)
+    set(key_material "python=${arg_PYTHON_EXECUTABLE}|${python_real_path}|${python_size}|${python_timestamp}\n")
+    string(APPEND key_material "python-version=${arg_PYTHON_VERSION}\n")
+
+    set(packages ${arg_PACKAGES})
+    list(SORT packages)
+    list(REMOVE_DUPLICATES packages)
+    string(APPEND key_material "packages=${packages}\n")
+    if(DEFINED arg_REQUIREMENTS_FILE)
+        file(SHA256 "${arg_REQUIREMENTS_FILE}" requirements_hash)
+        string(APPEND key_material "requirements=${requirements_hash}\n")
+    endif()
+    if(NOT "${VCPKG_PYTHON_WHEELHOUSE}" STREQUAL "")
+        file(GLOB wheels RELATIVE "${VCPKG_PYTHON_WHEELHOUSE}" "${VCPKG_PYTHON_WHEELHOUSE}/*")
+        list(SORT wheels)
+        string(APPEND key_material "wheelhouse=${VCPKG_PYTHON_WHEELHOUSE}\nwheels=${wheels}\n")
+    endif()
+    # Changes to the setup of the virtual environment invalidate the cache.
+    file(SHA256 "${CMAKE_CURRENT_FUNCTION_LIST_FILE}" script_hash)
+    string(APPEND key_material "script=${script_hash}\n")
+
+    string(SHA256 key "${key_material}")
+    string(SUBSTRING "${key}" 0 16 key)
+    set("${out_var}" "${key}" PARENT_SCOPE)
+    set("${arg_OUT_KEY_MATERIAL}" "${key_material}" PARENT_SCOPE)
+endfunction()
+
+# Sets out_var to ON when the cached virtual environment at venv_path is complete and was set up for key_material.
+function(z_vcpkg_get_python_packages_venv_complete out_var venv_path key_material)
+    set(cached_key_material "")
+    if(EXISTS "${venv_path}/vcpkg-venv-complete")
+        file(READ "${venv_path}/vcpkg-venv-complete" cached_key_material)
+    endif()
+    if(cached_key_material STREQUAL key_material)
+        set("${out_var}" ON PARENT_SCOPE)
+    else()
+        set("${out_var}" OFF PARENT_SCOPE)
+    endif()
+endfunction()
+
+# Replaces the path of the cached virtual environment in its copy at venv_path:
+# in pyvenv.cfg, the activation scripts and the shebangs of the scripts installed by pip.
+# The .exe launchers of virtualenv on Windows keep starting the interpreter of the cache, which has the same packages.
+function(z_vcpkg_get_python_packages_relocate_venv venv_path cached_venv_path python_sub_path)
+    file(GLOB scripts LIST_DIRECTORIES false "${venv_path}${python_sub_path}/*")
+    set(relocated_files "${venv_path}/pyvenv.cfg")
+    foreach(script IN LISTS scripts)
+        if(IS_SYMLINK "${script}")
+            continue()
+        endif()
+        get_filename_component(script_name "${script}" NAME)
+        file(READ "${script}" script_head LIMIT 2)
+        if(script_head MATCHES "^#!" OR script_name MATCHES "^[Aa]ctivate")
+            list(APPEND relocated_files "${script}")
+        endif()
+    endforeach()
+    foreach(relocated_file IN LISTS relocated_files)
+        if(EXISTS "${relocated_file}")
+            file(READ "${relocated_file}" contents)
+            string(REPLACE "${cached_venv_path}" "${venv_path}" contents "${contents}")
+            file(WRITE "${relocated_file}" "${contents}")
+        endif()
+    endforeach()
+endfunction()
+
 function(x_vcpkg_get_python_packages)
     cmake_parse_arguments(PARSE_ARGV 0 arg "" "PYTHON_VERSION;PYTHON_EXECUTABLE;REQUIREMENTS_FILE;OUT_PYTHON_VAR" "PACKAGES")
 
@@ -29,6 +105,11 @@ function(x_vcpkg_get_python_packages)
         message(FATAL_ERROR "${CMAKE_CURRENT_FUNCTION} was passed extra arguments: ${arg_UNPARSED_ARGUMENTS}")
     endif()
 
+    set(pip_options "")
+    if(NOT "${VCPKG_PYTHON_WHEELHOUSE}" STREQUAL "")
+        set(pip_options --no-index --find-links "${VCPKG_PYTHON_WHEELHOUSE}")
+    endif()
+
     get_filename_component(python_dir "${arg_PYTHON_EXECUTABLE}" DIRECTORY)
     set(ENV{PYTHONNOUSERSITE} "1")
     if(CMAKE_HOST_WIN32 AND
@@ -58,7 +139,7 @@ function(x_vcpkg_get_python_packages)
                                                    LOGNAME "get-pip-${TARGET_TRIPLET}")
                 endif()
             endif()
-            vcpkg_execute_required_process(COMMAND "${python_dir}/Scripts/pip${VCPKG_HOST_EXECUTABLE_SUFFIX}" install virtualenv --no-warn-script-location
+            vcpkg_execute_required_process(COMMAND "${python_dir}/Scripts/pip${VCPKG_HOST_EXECUTABLE_SUFFIX}" install virtualenv ${pip_options} --no-warn-script-location
                                            WORKING_DIRECTORY "${CURRENT_BUILDTREES_DIR}"
                                            LOGNAME "pip-install-virtualenv-${TARGET_TRIPLET}")
         else()
@@ -68,17 +149,40 @@ function(x_vcpkg_get_python_packages)
         endif()
     endif()
     set(venv_path "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-venv")
-    file(REMOVE_RECURSE "${venv_path}") # Remove old venv
-    file(MAKE_DIRECTORY "${venv_path}")
+    set(setup_path "${venv_path}")
+    set(venv_cached OFF)
+    if(NOT "${VCPKG_PYTHON_VENV_CACHE_DIR}" STREQUAL "")
+        z_vcpkg_get_python_packages_venv_key(venv_key
+            PYTHON_EXECUTABLE "${arg_PYTHON_EXECUTABLE}"
+            PYTHON_VERSION "${arg_PYTHON_VERSION}"
+            REQUIREMENTS_FILE ${arg_REQUIREMENTS_FILE}
+            OUT_KEY_MATERIAL venv_key_material
+            PACKAGES ${arg_PACKAGES}
+        )
+        # Virtual environments contain their own path, so they are set up in the cache and copied to the port.
+        # The lock serializes builds setting up the same environment; the marker is written last,
+        # and the cached environment is not changed afterwards.
+        set(setup_path "${VCPKG_PYTHON_VENV_CACHE_DIR}/${venv_key}")
+        z_vcpkg_get_python_packages_venv_complete(venv_cached "${setup_path}" "${venv_key_material}")
+        if(NOT venv_cached)
+            file(MAKE_DIRECTORY "${VCPKG_PYTHON_VENV_CACHE_DIR}")
+            file(LOCK "${setup_path}.lock" GUARD FUNCTION)
+            z_vcpkg_get_python_packages_venv_complete(venv_cached "${setup_path}" "${venv_key_material}")
+        endif()
+    endif()
+    if(NOT venv_cached)
+        file(REMOVE_RECURSE "${setup_path}") # Remove old venv
+        file(MAKE_DIRECTORY "${setup_path}")
+    endif()
     if(CMAKE_HOST_WIN32)
         file(MAKE_DIRECTORY "${python_dir}/DLLs")
         set(python_sub_path /Scripts)
         set(python_venv virtualenv)
         file(GLOB python_zipped_stdlib "${python_dir}/python3*.zip")
-        if(python_zipped_stdlib)
-            file(COPY ${python_zipped_stdlib} DESTINATION "${venv_path}/Scripts")
+        if(python_zipped_stdlib AND NOT venv_cached)
+            file(COPY ${python_zipped_stdlib} DESTINATION "${setup_path}/Scripts")
         endif()
-        set(python_venv_options "--app-data" "${venv_path}/data")
+        set(python_venv_options "--app-data" "${setup_path}/data")
     else()
         set(python_sub_path /bin)
         if(arg_PYTHON_VERSION STREQUAL 3)
@@ -90,28 +194,44 @@ function(x_vcpkg_get_python_packages)
     endif()
 
     set(ENV{PYTHONNOUSERSITE} "1")
-    message(STATUS "Setting up python virtual environment...")
-    vcpkg_execute_required_process(COMMAND "${arg_PYTHON_EXECUTABLE}" -I -m "${python_venv}" ${python_venv_options} "${venv_path}"
-                                   WORKING_DIRECTORY "${CURRENT_BUILDTREES_DIR}"
-                                   LOGNAME "venv-setup-${TARGET_TRIPLET}")
-    vcpkg_add_to_path(PREPEND "${venv_path}${python_sub_path}")
-    set(${arg_OUT_PYTHON_VAR} "${venv_path}${python_sub_path}/python${VCPKG_HOST_EXECUTABLE_SUFFIX}")
-    set(ENV{VIRTUAL_ENV} "${venv_path}")
+    if(venv_cached)
+        message(STATUS "Using cached python virtual environment ${venv_key}")
+    else()
+        message(STATUS "Setting up python virtual environment...")
+        vcpkg_execute_required_process(COMMAND "${arg_PYTHON_EXECUTABLE}" -I -m "${python_venv}" ${python_venv_options} "${setup_path}"
+                                       WORKING_DIRECTORY "${CURRENT_BUILDTREES_DIR}"
+                                       LOGNAME "venv-setup-${TARGET_TRIPLET}")
+    endif()
     unset(ENV{PYTHONHOME})
     unset(ENV{PYTHONPATH})
-    if(DEFINED arg_REQUIREMENTS_FILE)
-        message(STATUS "Installing requirements from: ${arg_REQUIREMENTS_FILE}")
-        vcpkg_execute_required_process(COMMAND "${${arg_OUT_PYTHON_VAR}}" -I -m pip install -r ${arg_REQUIREMENTS_FILE}
-                                       WORKING_DIRECTORY "${CURRENT_BUILDTREES_DIR}"
-                                       LOGNAME "pip-install-requirements-file-${TARGET_TRIPLET}")
+    if(NOT venv_cached)
+        set(setup_python "${setup_path}${python_sub_path}/python${VCPKG_HOST_EXECUTABLE_SUFFIX}")
+        set(ENV{VIRTUAL_ENV} "${setup_path}")
+        if(DEFINED arg_REQUIREMENTS_FILE)
+            message(STATUS "Installing requirements from: ${arg_REQUIREMENTS_FILE}")
+            vcpkg_execute_required_process(COMMAND "${setup_python}" -I -m pip install ${pip_options} -r ${arg_REQUIREMENTS_FILE}
+                                           WORKING_DIRECTORY "${CURRENT_BUILDTREES_DIR}"
+                                           LOGNAME "pip-install-requirements-file-${TARGET_TRIPLET}")
+        endif()
+        if(DEFINED arg_PACKAGES)
+            message(STATUS "Installing python packages: ${arg_PACKAGES}")
+            vcpkg_execute_required_process(COMMAND "${setup_python}" -I -m pip install ${pip_options} ${arg_PACKAGES}
+                                           WORKING_DIRECTORY "${CURRENT_BUILDTREES_DIR}"
+                                           LOGNAME "pip-install-packages-${TARGET_TRIPLET}")
+        endif()
+        if(NOT "${VCPKG_PYTHON_VENV_CACHE_DIR}" STREQUAL "")
+            file(WRITE "${setup_path}/vcpkg-venv-complete" "${venv_key_material}")
+        endif()
+        message(STATUS "Setting up python virtual environment... finished.")
     endif()
-    if(DEFINED arg_PACKAGES)
-        message(STATUS "Installing python packages: ${arg_PACKAGES}")
-        vcpkg_execute_required_process(COMMAND "${${arg_OUT_PYTHON_VAR}}" -I -m pip install ${arg_PACKAGES}
-                                       WORKING_DIRECTORY "${CURRENT_BUILDTREES_DIR}"
-                                       LOGNAME "pip-install-packages-${TARGET_TRIPLET}")
+    if(NOT "${VCPKG_PYTHON_VENV_CACHE_DIR}" STREQUAL "")
+        file(REMOVE_RECURSE "${venv_path}")
+        file(COPY "${setup_path}/" DESTINATION "${venv_path}" PATTERN "vcpkg-venv-complete" EXCLUDE)
+        z_vcpkg_get_python_packages_relocate_venv("${venv_path}" "${setup_path}" "${python_sub_path}")
     endif()
-    message(STATUS "Setting up python virtual environment... finished.")
+    vcpkg_add_to_path(PREPEND "${venv_path}${python_sub_path}")
+    set(${arg_OUT_PYTHON_VAR} "${venv_path}${python_sub_path}/python${VCPKG_HOST_EXECUTABLE_SUFFIX}")
+    set(ENV{VIRTUAL_ENV} "${venv_path}")
     set(${arg_OUT_PYTHON_VAR} "${${arg_OUT_PYTHON_VAR}}" PARENT_SCOPE)
     set(${arg_OUT_PYTHON_VAR} "${${arg_OUT_PYTHON_VAR}}" CACHE PATH "" FORCE)
 endfunction()
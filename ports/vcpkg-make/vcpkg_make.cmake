@@ -260,14 +260,15 @@ function(z_vcpkg_make_restore_env)
     )
 endfunction()
 
-function(vcpkg_make_run_configure)
-    cmake_parse_arguments(PARSE_ARGV 0 arg
-        "ADD_BIN_TO_PATH" 
-        "CONFIG;SHELL;WORKING_DIRECTORY;CONFIGURE_PATH;CONFIGURE_ENV"
+# Sets up the environment for configuring CONFIG and sets out_var to the shell command running configure.
+# The autoconf cache key of the configuration is returned in out_cache_key_var.
+function(z_vcpkg_make_prepare_configure out_var out_cache_key_var)
+    cmake_parse_arguments(PARSE_ARGV 2 arg
+        ""
+        "CONFIG;WORKING_DIRECTORY;CONFIGURE_PATH;CONFIGURE_ENV"
         "OPTIONS"
     )
     z_vcpkg_unparsed_args(FATAL_ERROR)
-    z_vcpkg_required_args(SHELL CONFIG WORKING_DIRECTORY CONFIGURE_PATH)
 
     vcpkg_prepare_pkgconfig("${arg_CONFIG}")
 
@@ -275,13 +276,58 @@ function(vcpkg_make_run_configure)
 
     z_vcpkg_make_prepare_env("${arg_CONFIG}" ${prepare_env_opts})
 
+    set(configure_script "${arg_CONFIGURE_PATH}")
+    if(NOT IS_ABSOLUTE "${configure_script}")
+        set(configure_script "${arg_WORKING_DIRECTORY}/${configure_script}")
+    endif()
+    z_vcpkg_autoconf_cache_key(autoconf_cache_key
+        CONFIG "${arg_CONFIG}"
+        CONFIGURE_SCRIPT "${configure_script}"
+        CONFIGURE_ENV "${arg_CONFIGURE_ENV}"
+        OPTIONS ${arg_OPTIONS}
+    )
+    z_vcpkg_autoconf_cache_restore(KEY "${autoconf_cache_key}" WORKING_DIRECTORY "${arg_WORKING_DIRECTORY}" OUT_OPTIONS_VAR autoconf_cache_options)
+    list(APPEND arg_OPTIONS ${autoconf_cache_options})
+
     vcpkg_list(SET tmp)
     foreach(element IN LISTS arg_OPTIONS)
         string(REPLACE [["]] [[\"]] element "${element}")
         vcpkg_list(APPEND tmp "\"${element}\"")
     endforeach()
     vcpkg_list(JOIN tmp " " "arg_OPTIONS")
-    set(command ${arg_CONFIGURE_ENV} ${arg_CONFIGURE_PATH} ${arg_OPTIONS})
+    set("${out_var}" ${arg_CONFIGURE_ENV} ${arg_CONFIGURE_PATH} ${arg_OPTIONS} PARENT_SCOPE)
+    set("${out_cache_key_var}" "${autoconf_cache_key}" PARENT_SCOPE)
+endfunction()
+
+# Post-processes the configured build tree in working_directory and stores its autoconf results.
+function(z_vcpkg_make_finish_configure working_directory autoconf_cache_key)
+    z_vcpkg_autoconf_cache_store(KEY "${autoconf_cache_key}" WORKING_DIRECTORY "${working_directory}")
+    if(VCPKG_TARGET_IS_WINDOWS AND NOT VCPKG_TARGET_IS_MINGW AND VCPKG_LIBRARY_LINKAGE STREQUAL dynamic)
+        file(GLOB_RECURSE libtool_files "${working_directory}*/libtool")
+        foreach(lt_file IN LISTS libtool_files)
+            file(READ "${lt_file}" _contents)
+            string(REPLACE ".dll.lib" ".lib" _contents "${_contents}")
+            file(WRITE "${lt_file}" "${_contents}")
+        endforeach()
+    endif()
+endfunction()
+
+function(vcpkg_make_run_configure)
+    cmake_parse_arguments(PARSE_ARGV 0 arg
+        "ADD_BIN_TO_PATH" 
+        "CONFIG;SHELL;WORKING_DIRECTORY;CONFIGURE_PATH;CONFIGURE_ENV"
+        "OPTIONS"
+    )
+    z_vcpkg_unparsed_args(FATAL_ERROR)
+    z_vcpkg_required_args(SHELL CONFIG WORKING_DIRECTORY CONFIGURE_PATH)
+
+    z_vcpkg_make_prepare_configure(command autoconf_cache_key
+        CONFIG "${arg_CONFIG}"
+        WORKING_DIRECTORY "${arg_WORKING_DIRECTORY}"
+        CONFIGURE_PATH "${arg_CONFIGURE_PATH}"
+        CONFIGURE_ENV "${arg_CONFIGURE_ENV}"
+        OPTIONS ${arg_OPTIONS}
+    )
 
     message(STATUS "Configuring ${TARGET_TRIPLET}-${suffix_${arg_CONFIG}}")
     vcpkg_run_shell(
@@ -291,14 +337,7 @@ function(vcpkg_make_run_configure)
         SHELL ${arg_SHELL}
         COMMAND V=1 ${command}
     )
-    if(VCPKG_TARGET_IS_WINDOWS AND NOT VCPKG_TARGET_IS_MINGW AND VCPKG_LIBRARY_LINKAGE STREQUAL dynamic)
-        file(GLOB_RECURSE libtool_files "${arg_WORKING_DIRECTORY}*/libtool")
-        foreach(lt_file IN LISTS libtool_files)
-            file(READ "${lt_file}" _contents)
-            string(REPLACE ".dll.lib" ".lib" _contents "${_contents}")
-            file(WRITE "${lt_file}" "${_contents}")
-        endforeach()
-    endif()
+    z_vcpkg_make_finish_configure("${arg_WORKING_DIRECTORY}" "${autoconf_cache_key}")
     z_vcpkg_make_restore_env()
     vcpkg_restore_pkgconfig()
 endfunction()
@@ -389,6 +389,10 @@ function(z_vcpkg_make_prepare_programs out_env)
                 if(ARGN)
                     string(APPEND prog " ${ARGN}")
                 endif()
+                if(envvar MATCHES "^(CC|CXX)(_FOR_BUILD)?$" AND NOT "${VCPKG_COMPILER_LAUNCHER}" STREQUAL "")
+                    list(JOIN VCPKG_COMPILER_LAUNCHER " " compiler_launcher)
+                    set(prog "${compiler_launcher} ${prog}")
+                endif()
                 set(z_vcm_all_tools "${z_vcm_all_tools}" PARENT_SCOPE)
             endif()
             z_vcpkg_append_to_configure_environment(configure_env "${envvar}" "${prog}")
@@ -2,8 +2,9 @@ include_guard(GLOBAL)
 include("${CMAKE_CURRENT_LIST_DIR}/vcpkg_make.cmake")
 
 function(vcpkg_make_configure)
+    z_vcpkg_profile_begin(configure vcpkg_make_configure)
     cmake_parse_arguments(PARSE_ARGV 0 arg
-        "AUTORECONF;COPY_SOURCE;DISABLE_MSVC_WRAPPERS;DISABLE_CPPFLAGS;DISABLE_DEFAULT_OPTIONS;DISABLE_MSVC_TRANSFORMATIONS"
+        "AUTORECONF;COPY_SOURCE;DISABLE_MSVC_WRAPPERS;DISABLE_CPPFLAGS;DISABLE_DEFAULT_OPTIONS;DISABLE_MSVC_TRANSFORMATIONS;DISABLE_PARALLEL_CONFIGURE"
         "SOURCE_PATH"
         "OPTIONS;OPTIONS_DEBUG;OPTIONS_RELEASE;PRE_CONFIGURE_CMAKE_COMMANDS;LANGUAGES"
     )
@@ -82,6 +83,21 @@ function(vcpkg_make_configure)
         set(EMMAKEN_JUST_CONFIGURE 1) # as in emconfigure
     endif()
 
+    # The environment which z_vcpkg_make_prepare_configure sets up for each configuration.
+    set(config_env_vars
+        ${cm_FLAGS} CPPFLAGS_FOR_BUILD CFLAGS_FOR_BUILD LDFLAGS_FOR_BUILD CC_FOR_BUILD CPP_FOR_BUILD CXX_FOR_BUILD
+        PATH C_INCLUDE_PATH CPLUS_INCLUDE_PATH LIBRARY_PATH LD_LIBRARY_PATH INCLUDE LIB LIBPATH _CL_ _LINK_
+        PKG_CONFIG PKG_CONFIG_PATH EMMAKEN_JUST_CONFIGURE
+    )
+
+    # configure scripts are single-threaded, so the configurations are configured concurrently.
+    set(configure_in_parallel OFF)
+    list(LENGTH buildtypes buildtype_count)
+    if(NOT arg_DISABLE_PARALLEL_CONFIGURE AND buildtype_count GREATER "1" AND VCPKG_CONCURRENCY GREATER "1")
+        z_vcpkg_execute_build_process_parallel_supported(configure_in_parallel)
+    endif()
+    set(parallel_configs "")
+
     foreach(config IN LISTS buildtypes)
         string(TOUPPER "${config}" configup)
         set(target_dir "${workdir_${configup}}")
@@ -106,6 +122,30 @@ function(vcpkg_make_configure)
             cmake_language(CALL ${cmd} ${configup})
         endforeach()
 
+        if(configure_in_parallel)
+            set(short_name "${suffix_${configup}}")
+            z_vcpkg_make_prepare_configure(command "autoconf_cache_key_${short_name}"
+                CONFIG "${configup}"
+                WORKING_DIRECTORY "${target_dir}"
+                CONFIGURE_PATH "${configure_path_from_wd}"
+                CONFIGURE_ENV "${configure_env}"
+                OPTIONS
+                    ${BUILD_TRIPLET}
+                    ${arg_OPTIONS}
+                    ${opts}
+                    ${arg_OPTIONS_${configup}}
+            )
+            vcpkg_list(JOIN command " " command)
+            set("${short_name}_command" ${shell_cmd} -c "V=1 ${command}")
+            set("${short_name}_working_directory" "${target_dir}")
+            set("${short_name}_logname" "config-${TARGET_TRIPLET}-${short_name}")
+            z_vcpkg_snapshot_env_variables("${short_name}_environment" VARS ${config_env_vars})
+            list(APPEND parallel_configs "${short_name}")
+            z_vcpkg_make_restore_env()
+            vcpkg_restore_pkgconfig()
+            continue()
+        endif()
+
         vcpkg_make_run_configure(SHELL
                                     "${shell_cmd}"
                                  CONFIG
@@ -125,6 +165,37 @@ function(vcpkg_make_configure)
                                 )
     endforeach()
 
+    if(configure_in_parallel)
+        list(TRANSFORM parallel_configs PREPEND "${TARGET_TRIPLET}-" OUTPUT_VARIABLE parallel_config_names)
+        list(JOIN parallel_config_names " and " parallel_config_names)
+        message(STATUS "Configuring ${parallel_config_names} in parallel")
+        z_vcpkg_execute_build_process_parallel(
+            PROCESSES ${parallel_configs}
+            WORKING_DIRECTORY "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-parallel-configure"
+            LOGNAME "config-${TARGET_TRIPLET}-parallel"
+            OUT_FAILED_VAR failed_configs
+        )
+        foreach(short_name IN LISTS parallel_configs)
+            set(target_dir "${${short_name}_working_directory}")
+            if(short_name IN_LIST failed_configs)
+                # Configure again on its own to report the failure with the usual logs.
+                message(STATUS "Parallel configure failed for ${TARGET_TRIPLET}-${short_name}; configuring again on its own")
+                z_vcpkg_snapshot_env_variables(env_before_config VARS ${config_env_vars})
+                cmake_language(EVAL CODE "${${short_name}_environment}")
+                vcpkg_execute_required_process(
+                    COMMAND ${${short_name}_command}
+                    WORKING_DIRECTORY "${target_dir}"
+                    LOGNAME "${${short_name}_logname}"
+                    SAVE_LOG_FILES config.log
+                )
+                cmake_language(EVAL CODE "${env_before_config}")
+            elseif(EXISTS "${target_dir}/config.log")
+                configure_file("${target_dir}/config.log" "${CURRENT_BUILDTREES_DIR}/${${short_name}_logname}-config.log" COPYONLY)
+            endif()
+            z_vcpkg_make_finish_configure("${target_dir}" "${autoconf_cache_key_${short_name}}")
+        endforeach()
+    endif()
+
     # Restore environment
     vcpkg_restore_env_variables(VARS 
         ${cm_FLAGS} 
@@ -138,4 +209,5 @@ function(vcpkg_make_configure)
     else()
         find_program(Z_VCPKG_MAKE NAMES make gmake NAMES_PER_DIR REQUIRED)
     endif()
+    z_vcpkg_profile_end(vcpkg_make_configure)
 endfunction()
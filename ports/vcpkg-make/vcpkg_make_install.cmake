@@ -2,6 +2,7 @@ include_guard(GLOBAL)
 include("${CMAKE_CURRENT_LIST_DIR}/vcpkg_make.cmake")
 
 function(vcpkg_make_install)
+    z_vcpkg_profile_begin(install vcpkg_make_install)
     cmake_parse_arguments(PARSE_ARGV 0 arg
         "DISABLE_PARALLEL"
         "LOGFILE_ROOT;MAKEFILE"
@@ -146,4 +147,5 @@ function(vcpkg_make_install)
     endif()
 
     vcpkg_restore_env_variables(VARS LIB LIBPATH LIBRARY_PATH LD_LIBRARY_PATH CPPFLAGS CFLAGS CXXFLAGS RCFLAGS)
+    z_vcpkg_profile_end(vcpkg_make_install)
 endfunction()
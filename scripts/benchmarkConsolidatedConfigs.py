@@ -0,0 +1,198 @@
+import os
+import sys
+import json
+import time
+import shutil
+import argparse
+import tempfile
+import statistics
+import subprocess
+
+from pathlib import Path
+
+
+SCRIPT_DIRECTORY = Path(__file__).resolve().parent
+VCPKG_ROOT = SCRIPT_DIRECTORY.parent
+TEST_PORTS = SCRIPT_DIRECTORY / 'test_ports'
+TOOLCHAIN_FILE = SCRIPT_DIRECTORY / 'buildsystems' / 'vcpkg.cmake'
+FIXUP_SCRIPT = VCPKG_ROOT / 'ports' / 'vcpkg-cmake-config' / 'vcpkg_cmake_config_fixup.cmake'
+
+# Measures how VCPKG_CMAKE_CONFIG_CONSOLIDATE changes the configure time of consumers, using the
+# test projects of the vcpkg-ci-* ports against an installed tree.
+#
+# The consolidated variant is a mirror of the installed tree: share/ of the triplet is copied and
+# consolidated, everything else is linked. Each project is configured once per variant to detect
+# the compilers, then reconfigured --runs times, alternating between the variants. The find_package()
+# time is taken from the profile of VCPKG_PROFILE_FIND_PACKAGE, which needs CMake 3.23.
+#
+# The projects are configured without the options of their portfiles; projects which need those
+# options, or whose dependencies are not installed, are reported and skipped.
+
+
+def link_or_copy(source, destination):
+    try:
+        os.symlink(source, destination, target_is_directory=source.is_dir())
+    except OSError:
+        if source.is_dir():
+            shutil.copytree(source, destination, symlinks=True)
+        else:
+            shutil.copy2(source, destination)
+
+
+def count_cmake_files(directory):
+    return sum(1 for _ in directory.rglob('*.cmake'))
+
+
+def create_consolidated_mirror(cmake, installed_dir, triplet, mirror_dir):
+    mirror_dir.mkdir(parents=True)
+    for entry in installed_dir.iterdir():
+        if entry.name != triplet:
+            link_or_copy(entry, mirror_dir / entry.name)
+            continue
+        (mirror_dir / triplet).mkdir()
+        for triplet_entry in entry.iterdir():
+            if triplet_entry.name == 'share':
+                shutil.copytree(triplet_entry, mirror_dir / triplet / 'share', symlinks=True)
+            else:
+                link_or_copy(triplet_entry, mirror_dir / triplet / triplet_entry.name)
+
+    share_dir = mirror_dir / triplet / 'share'
+    script = mirror_dir.parent / 'consolidate.cmake'
+    script.write_text(f'include([==[{FIXUP_SCRIPT.as_posix()}]==])\n'
+                      f'z_vcpkg_cmake_config_consolidate([==[{share_dir.as_posix()}]==])\n', encoding='utf-8')
+    subprocess.run([cmake, '-P', str(script)], check=True)
+
+
+def configure(cmake, project_dir, build_dir, installed_dir, triplet, generator):
+    command = [
+        cmake,
+        '-S', str(project_dir),
+        '-B', str(build_dir),
+        f'-DCMAKE_TOOLCHAIN_FILE={TOOLCHAIN_FILE}',
+        f'-DVCPKG_INSTALLED_DIR={installed_dir}',
+        f'-DVCPKG_TARGET_TRIPLET={triplet}',
+        '-DVCPKG_MANIFEST_MODE=OFF',
+        '-DVCPKG_PROFILE_FIND_PACKAGE=ON',
+        '-DCMAKE_BUILD_TYPE=Release',
+    ]
+    if generator:
+        command += ['-G', generator]
+    start_time = time.perf_counter()
+    output = subprocess.run(command, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, encoding='utf-8')
+    configure_ms = (time.perf_counter() - start_time) * 1000
+    if output.returncode != 0:
+        return None, output.stdout
+    with open(build_dir / 'vcpkg-find-package-profile.json', 'r', encoding='utf-8') as profile_file:
+        profile = json.load(profile_file)
+    included_files = sum(call['included_files'] for call in profile['calls'])
+    return (configure_ms, profile['total_us'] / 1000, included_files), output.stdout
+
+
+def find_projects(ports):
+    if not ports:
+        ports = sorted(path.name for path in TEST_PORTS.glob('vcpkg-ci-*'))
+    projects = {}
+    for port in ports:
+        project_dir = TEST_PORTS / port / 'project'
+        if (project_dir / 'CMakeLists.txt').exists():
+            projects[port] = project_dir
+    return projects
+
+
+def benchmark(args, work_dir):
+    installed_dir = Path(args.installed_dir).resolve()
+    if not (installed_dir / args.triplet / 'share').is_dir():
+        sys.exit(f'benchmark: {installed_dir / args.triplet} has no installed packages')
+    mirror_dir = work_dir / 'consolidated' / 'installed'
+    create_consolidated_mirror(args.cmake, installed_dir, args.triplet, mirror_dir)
+    variants = {'original': installed_dir, 'consolidated': mirror_dir}
+    files = {name: count_cmake_files(path / args.triplet / 'share') for name, path in variants.items()}
+    print(f'benchmark: {files["original"]} *.cmake files in share, {files["consolidated"]} consolidated')
+
+    results = {}
+    for port, project_dir in find_projects(args.ports).items():
+        samples = {name: [] for name in variants}
+        for run in range(args.runs + 1):
+            for name, variant_installed_dir in variants.items():
+                build_dir = work_dir / 'build' / port / name
+                sample, output = configure(args.cmake, project_dir, build_dir, variant_installed_dir,
+                                           args.triplet, args.generator)
+                if sample is None:
+                    print(f'benchmark: skipping {port}, the {name} configure failed:\n{output.strip()}',
+                          file=sys.stderr)
+                    break
+                # The first configure detects the compilers.
+                if run != 0:
+                    samples[name].append(sample)
+            else:
+                continue
+            break
+        else:
+            results[port] = {name: tuple(statistics.median(values) for values in zip(*variant_samples))
+                             for name, variant_samples in samples.items()}
+            print(f'benchmark: measured {port}')
+    return results
+
+
+def print_results(results):
+    header = f'{"project":<36}{"files":>14}{"find_package ms":>22}{"configure ms":>22}'
+    print(f'\n{header}\n{"":<36}{"before":>7}{"after":>7}{"before":>11}{"after":>11}{"before":>11}{"after":>11}')
+    totals = {'original': [0, 0, 0], 'consolidated': [0, 0, 0]}
+    for port, variants in sorted(results.items()):
+        original_configure, original_find, original_files = variants['original']
+        consolidated_configure, consolidated_find, consolidated_files = variants['consolidated']
+        print(f'{port:<36}{original_files:>7.0f}{consolidated_files:>7.0f}'
+              f'{original_find:>11.1f}{consolidated_find:>11.1f}'
+              f'{original_configure:>11.0f}{consolidated_configure:>11.0f}')
+        for name, (configure_ms, find_ms, included_files) in variants.items():
+            totals[name][0] += configure_ms
+            totals[name][1] += find_ms
+            totals[name][2] += included_files
+    original_configure, original_find, original_files = totals['original']
+    consolidated_configure, consolidated_find, consolidated_files = totals['consolidated']
+    print(f'{"total":<36}{original_files:>7.0f}{consolidated_files:>7.0f}'
+          f'{original_find:>11.1f}{consolidated_find:>11.1f}'
+          f'{original_configure:>11.0f}{consolidated_configure:>11.0f}')
+    if original_find > 0 and original_configure > 0:
+        print(f'\nfind_package() time {100 * (consolidated_find / original_find - 1):+.1f}%, '
+              f'configure time {100 * (consolidated_configure / original_configure - 1):+.1f}%')
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compares the configure time of the vcpkg-ci-* test projects with and without '
+                    'consolidated CMake config files.',
+        epilog='Example: python benchmarkConsolidatedConfigs.py --triplet x64-linux vcpkg-ci-curl vcpkg-ci-boost')
+    parser.add_argument('--installed-dir', default=VCPKG_ROOT / 'installed',
+                        help='The installed tree with the dependencies of the projects.')
+    parser.add_argument('--triplet', required=True,
+                        help='The triplet of the installed packages.')
+    parser.add_argument('--cmake', default='cmake',
+                        help='The CMake executable, at least version 3.23.')
+    parser.add_argument('--generator',
+                        help='The CMake generator.')
+    parser.add_argument('--runs', type=int, default=5,
+                        help='The number of measured configure runs per project and variant.')
+    parser.add_argument('--work-dir',
+                        help='Keep the mirror and the build directories in this directory.')
+    parser.add_argument('ports', nargs='*',
+                        help='The vcpkg-ci-* ports whose projects are configured, all by default.')
+    args = parser.parse_args()
+    if args.runs < 1:
+        parser.error('--runs must be at least 1')
+
+    if args.work_dir:
+        work_dir = Path(args.work_dir).resolve()
+        if work_dir.exists():
+            parser.error(f'{work_dir} already exists')
+        results = benchmark(args, work_dir)
+    else:
+        with tempfile.TemporaryDirectory(prefix='vcpkg-consolidate-') as work_dir:
+            results = benchmark(args, Path(work_dir))
+    if not results:
+        sys.exit('benchmark: no project could be configured')
+    print_results(results)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,77 @@
+[CmdletBinding()]
+param (
+    # The ports to install; their boost dependencies are built as well.
+    $ports = @("boost-filesystem", "boost-program-options", "boost-regex", "boost-serialization", "boost-thread"),
+    $triplet = $null,
+    $workDir = $null,
+    $vcpkg = $null
+)
+
+# Compares the total wall time of building boost ports with and without
+# VCPKG_BOOST_BUILD_TREE_CACHE_DIR. Binary caching is disabled, so that every port is built.
+
+$ErrorActionPreference = 'Stop'
+
+$scriptsBoostDir = split-path -parent $MyInvocation.MyCommand.Definition
+$vcpkgRoot = "$scriptsBoostDir/../.."
+if ($null -eq $vcpkg) {
+    $vcpkg = "$vcpkgRoot/vcpkg"
+    if ($IsWindows) {
+        $vcpkg = "$vcpkg.exe"
+    }
+}
+if ($null -eq $triplet) {
+    if ($IsWindows) {
+        $triplet = "x64-windows"
+    } elseif ($IsMacOS) {
+        $triplet = "arm64-osx"
+    } else {
+        $triplet = "x64-linux"
+    }
+}
+if ($null -eq $workDir) {
+    $workDir = Join-Path ([System.IO.Path]::GetTempPath()) "vcpkg-boost-benchmark"
+}
+
+Remove-Item -Recurse -Force $workDir -ErrorAction SilentlyContinue
+# Download the sources first, so that neither mode pays for them.
+& $vcpkg install $ports "--triplet=$triplet" "--x-install-root=$workDir/downloads-only" --only-downloads --classic | Write-Verbose
+if ($LASTEXITCODE -ne 0) {
+    throw "Downloading the sources failed"
+}
+
+$results = [ordered]@{}
+foreach ($mode in @("per-port", "build-tree-cache")) {
+    $modeDir = "$workDir/$mode"
+    New-Item -ItemType Directory -Force $modeDir | Out-Null
+    if ($mode -eq "build-tree-cache") {
+        # The cache must be on the same volume as the buildtrees.
+        $env:VCPKG_BOOST_BUILD_TREE_CACHE_DIR = "$modeDir/build-tree-cache"
+        $env:VCPKG_KEEP_ENV_VARS = "VCPKG_BOOST_BUILD_TREE_CACHE_DIR"
+    } else {
+        Remove-Item Env:VCPKG_BOOST_BUILD_TREE_CACHE_DIR -ErrorAction SilentlyContinue
+        Remove-Item Env:VCPKG_KEEP_ENV_VARS -ErrorAction SilentlyContinue
+    }
+
+    $arguments = @(
+        "install"
+        $ports
+        "--triplet=$triplet"
+        "--x-install-root=$modeDir/installed"
+        "--x-buildtrees-root=$modeDir/buildtrees"
+        "--x-packages-root=$modeDir/packages"
+        "--binarysource=clear"
+        "--classic"
+    )
+    Write-Host "Building $($ports -join ', ') for $triplet ($mode)"
+    $elapsed = Measure-Command { & $vcpkg @arguments | Write-Verbose }
+    if ($LASTEXITCODE -ne 0) {
+        throw "vcpkg install failed for $mode, see $modeDir/buildtrees"
+    }
+    $results[$mode] = $elapsed.TotalSeconds
+}
+
+foreach ($mode in $results.Keys) {
+    Write-Host ("{0,-18} {1,10:N1} s" -f $mode, $results[$mode])
+}
+Write-Host ("{0,-18} {1,10:N1} %" -f "saved", (100 * (1 - $results["build-tree-cache"] / $results["per-port"])))
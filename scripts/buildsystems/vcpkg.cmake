@@ -107,6 +107,15 @@ Install the dependencies listed in your manifest:
     "VCPKG_MANIFEST_MODE"
     OFF)
 
+CMAKE_DEPENDENT_OPTION(VCPKG_MANIFEST_INSTALL_SKIP_UNCHANGED [[
+Skip the manifest install when its inputs did not change since the last successful install
+    into the same installed directory, and the installed directory was not modified since.
+]]
+    ON
+    "VCPKG_MANIFEST_INSTALL"
+    OFF)
+mark_as_advanced(VCPKG_MANIFEST_INSTALL_SKIP_UNCHANGED)
+
 if(VCPKG_MANIFEST_INSTALL)
     set(VCPKG_BOOTSTRAP_OPTIONS "${VCPKG_BOOTSTRAP_OPTIONS}" CACHE STRING "Additional options to bootstrap vcpkg" FORCE)
     set(VCPKG_OVERLAY_PORTS "${VCPKG_OVERLAY_PORTS}" CACHE STRING "Overlay ports to use for vcpkg install in manifest mode" FORCE)
@@ -464,6 +473,127 @@ else()
     set(Z_VCPKG_BOOTSTRAP_SCRIPT "${Z_VCPKG_ROOT_DIR}/bootstrap-vcpkg.sh")
 endif()
 
+#[===[.md:
+# z_vcpkg_manifest_install_fingerprint
+Compute the fingerprint of a manifest install.
+
+```cmake
+z_vcpkg_manifest_install_fingerprint(<out-var> <install-arguments>...)
+```
+
+The fingerprint covers the install arguments, the manifest, the vcpkg configuration,
+the triplet files, the overlays, the builtin ports and scripts, the vcpkg executable
+and the status of the installed directory.
+Files are identified by their timestamps, so that the fingerprint of a large overlay is cheap.
+In a git checkout of vcpkg, the builtin ports and scripts are identified by the commit
+and the files which differ from it.
+#]===]
+function(z_vcpkg_manifest_install_fingerprint out_var)
+    set(fingerprint_files
+        "${Z_VCPKG_EXECUTABLE}"
+        "${Z_VCPKG_ROOT_DIR}/versions/baseline.json"
+        "${VCPKG_MANIFEST_DIR}/vcpkg.json"
+        "${VCPKG_MANIFEST_DIR}/vcpkg-configuration.json"
+    )
+    set(overlay_dirs ${VCPKG_OVERLAY_PORTS} ${VCPKG_OVERLAY_TRIPLETS})
+    foreach(env_var IN ITEMS VCPKG_OVERLAY_PORTS VCPKG_OVERLAY_TRIPLETS)
+        if(DEFINED ENV{${env_var}})
+            file(TO_CMAKE_PATH "$ENV{${env_var}}" env_dirs)
+            list(APPEND overlay_dirs ${env_dirs})
+        endif()
+    endforeach()
+    list(APPEND overlay_dirs "${Z_VCPKG_ROOT_DIR}/triplets")
+    foreach(overlay_dir IN LISTS overlay_dirs)
+        if(IS_DIRECTORY "${overlay_dir}")
+            file(GLOB_RECURSE overlay_files LIST_DIRECTORIES false "${overlay_dir}/*")
+            list(SORT overlay_files)
+            list(APPEND fingerprint_files ${overlay_files})
+        else()
+            list(APPEND fingerprint_files "${overlay_dir}")
+        endif()
+    endforeach()
+
+    string(REPLACE ";" "\n" fingerprint "${ARGN}")
+    string(APPEND fingerprint "\n")
+
+    set(registry_dirs ports scripts)
+    find_program(Z_VCPKG_GIT NAMES git git.cmd)
+    mark_as_advanced(Z_VCPKG_GIT)
+    set(registry_status_result 1)
+    if(EXISTS "${Z_VCPKG_ROOT_DIR}/.git" AND Z_VCPKG_GIT)
+        execute_process(
+            COMMAND "${Z_VCPKG_GIT}" rev-parse HEAD
+            WORKING_DIRECTORY "${Z_VCPKG_ROOT_DIR}"
+            OUTPUT_VARIABLE registry_head
+            ERROR_QUIET
+            RESULT_VARIABLE registry_head_result
+        )
+        execute_process(
+            COMMAND "${Z_VCPKG_GIT}" -c core.quotePath=false status --porcelain --untracked-files=all -- ${registry_dirs}
+            WORKING_DIRECTORY "${Z_VCPKG_ROOT_DIR}"
+            OUTPUT_VARIABLE registry_status
+            ERROR_QUIET
+            RESULT_VARIABLE registry_status_result
+        )
+        if(NOT registry_head_result STREQUAL "0")
+            set(registry_status_result 1)
+        endif()
+    endif()
+    if(registry_status_result STREQUAL "0")
+        string(APPEND fingerprint "HEAD=${registry_head}${registry_status}")
+        # Further edits of a modified file keep its status line.
+        string(REGEX MATCHALL "[^\n]+" registry_status_lines "${registry_status}")
+        foreach(registry_status_line IN LISTS registry_status_lines)
+            string(REGEX REPLACE "^.. (.* -> )?" "" registry_file "${registry_status_line}")
+            list(APPEND fingerprint_files "${Z_VCPKG_ROOT_DIR}/${registry_file}")
+        endforeach()
+    else()
+        foreach(registry_dir IN LISTS registry_dirs)
+            file(GLOB_RECURSE registry_files LIST_DIRECTORIES false "${Z_VCPKG_ROOT_DIR}/${registry_dir}/*")
+            list(SORT registry_files)
+            list(APPEND fingerprint_files ${registry_files})
+        endforeach()
+    endif()
+    foreach(env_var IN ITEMS
+        VCPKG_ROOT VCPKG_FEATURE_FLAGS VCPKG_DEFAULT_TRIPLET VCPKG_DEFAULT_HOST_TRIPLET
+        VCPKG_OVERLAY_PORTS VCPKG_OVERLAY_TRIPLETS VCPKG_KEEP_ENV_VARS
+    )
+        string(APPEND fingerprint "ENV{${env_var}}=$ENV{${env_var}}\n")
+    endforeach()
+    foreach(fingerprint_file IN LISTS fingerprint_files)
+        if(EXISTS "${fingerprint_file}")
+            file(TIMESTAMP "${fingerprint_file}" file_timestamp "%Y-%m-%dT%H:%M:%S" UTC)
+            string(APPEND fingerprint "${fingerprint_file}|${file_timestamp}\n")
+        else()
+            string(APPEND fingerprint "${fingerprint_file}|missing\n")
+        endif()
+    endforeach()
+    # The manifest is small; its contents also catch edits which keep the timestamp.
+    foreach(manifest_file IN ITEMS "${VCPKG_MANIFEST_DIR}/vcpkg.json" "${VCPKG_MANIFEST_DIR}/vcpkg-configuration.json")
+        if(EXISTS "${manifest_file}")
+            file(SHA256 "${manifest_file}" file_hash)
+            string(APPEND fingerprint "${manifest_file}=${file_hash}\n")
+        endif()
+    endforeach()
+
+    # Any install or removal in the installed directory updates the status database.
+    set(status_files "${_VCPKG_INSTALLED_DIR}/vcpkg/status")
+    file(GLOB status_updates "${_VCPKG_INSTALLED_DIR}/vcpkg/updates/*")
+    list(SORT status_updates)
+    list(APPEND status_files ${status_updates})
+    foreach(status_file IN LISTS status_files)
+        if(EXISTS "${status_file}")
+            file(TIMESTAMP "${status_file}" file_timestamp "%Y-%m-%dT%H:%M:%S" UTC)
+            string(APPEND fingerprint "${status_file}|${file_timestamp}\n")
+        else()
+            string(APPEND fingerprint "${status_file}|missing\n")
+        endif()
+    endforeach()
+
+    string(SHA256 fingerprint "${fingerprint}")
+    set("${out_var}" "${fingerprint}" PARENT_SCOPE)
+endfunction()
+
 if(VCPKG_MANIFEST_MODE AND VCPKG_MANIFEST_INSTALL AND NOT Z_VCPKG_CMAKE_IN_TRY_COMPILE AND NOT Z_VCPKG_HAS_FATAL_ERROR)
     if(NOT EXISTS "${Z_VCPKG_EXECUTABLE}" AND NOT Z_VCPKG_HAS_FATAL_ERROR)
         message(STATUS "Bootstrapping vcpkg before install")
@@ -523,28 +653,53 @@ if(VCPKG_MANIFEST_MODE AND VCPKG_MANIFEST_INSTALL AND NOT Z_VCPKG_CMAKE_IN_TRY_C
             set(Z_VCPKG_MANIFEST_INSTALL_ECHO_PARAMS)
         endif()
 
-        execute_process(
-            COMMAND "${Z_VCPKG_EXECUTABLE}" install
-                --triplet "${VCPKG_TARGET_TRIPLET}"
-                --vcpkg-root "${Z_VCPKG_ROOT_DIR}"
-                "--x-wait-for-lock"
-                "--x-manifest-root=${VCPKG_MANIFEST_DIR}"
-                "--x-install-root=${_VCPKG_INSTALLED_DIR}"
-                ${Z_VCPKG_FEATURE_FLAGS}
-                ${Z_VCPKG_ADDITIONAL_MANIFEST_PARAMS}
-                ${VCPKG_INSTALL_OPTIONS}
-            OUTPUT_VARIABLE Z_VCPKG_MANIFEST_INSTALL_LOGTEXT
-            ERROR_VARIABLE Z_VCPKG_MANIFEST_INSTALL_LOGTEXT
-            RESULT_VARIABLE Z_VCPKG_MANIFEST_INSTALL_RESULT
-            ${Z_VCPKG_MANIFEST_INSTALL_ECHO_PARAMS}
+        set(Z_VCPKG_MANIFEST_INSTALL_ARGS
+            --triplet "${VCPKG_TARGET_TRIPLET}"
+            --vcpkg-root "${Z_VCPKG_ROOT_DIR}"
+            "--x-wait-for-lock"
+            "--x-manifest-root=${VCPKG_MANIFEST_DIR}"
+            "--x-install-root=${_VCPKG_INSTALLED_DIR}"
+            ${Z_VCPKG_FEATURE_FLAGS}
+            ${Z_VCPKG_ADDITIONAL_MANIFEST_PARAMS}
+            ${VCPKG_INSTALL_OPTIONS}
         )
-
         set(Z_VCPKG_MANIFEST_INSTALL_LOGFILE "${CMAKE_BINARY_DIR}/vcpkg-manifest-install.log")
         file(TO_NATIVE_PATH "${Z_VCPKG_MANIFEST_INSTALL_LOGFILE}" Z_NATIVE_VCPKG_MANIFEST_INSTALL_LOGFILE)
-        file(WRITE "${Z_VCPKG_MANIFEST_INSTALL_LOGFILE}" "${Z_VCPKG_MANIFEST_INSTALL_LOGTEXT}")
+        set(Z_VCPKG_MANIFEST_INSTALL_FINGERPRINT_FILE "${CMAKE_BINARY_DIR}/vcpkg-manifest-install.fingerprint")
+
+        set(Z_VCPKG_MANIFEST_INSTALL_UP_TO_DATE OFF)
+        if(VCPKG_MANIFEST_INSTALL_SKIP_UNCHANGED AND EXISTS "${Z_VCPKG_MANIFEST_INSTALL_FINGERPRINT_FILE}")
+            z_vcpkg_manifest_install_fingerprint(Z_VCPKG_MANIFEST_INSTALL_FINGERPRINT ${Z_VCPKG_MANIFEST_INSTALL_ARGS})
+            file(READ "${Z_VCPKG_MANIFEST_INSTALL_FINGERPRINT_FILE}" Z_VCPKG_MANIFEST_INSTALL_PREVIOUS_FINGERPRINT)
+            if(Z_VCPKG_MANIFEST_INSTALL_FINGERPRINT STREQUAL Z_VCPKG_MANIFEST_INSTALL_PREVIOUS_FINGERPRINT)
+                set(Z_VCPKG_MANIFEST_INSTALL_UP_TO_DATE ON)
+            endif()
+        endif()
+
+        if(Z_VCPKG_MANIFEST_INSTALL_UP_TO_DATE)
+            set(Z_VCPKG_MANIFEST_INSTALL_RESULT 0)
+        else()
+            file(REMOVE "${Z_VCPKG_MANIFEST_INSTALL_FINGERPRINT_FILE}")
+            execute_process(
+                COMMAND "${Z_VCPKG_EXECUTABLE}" install ${Z_VCPKG_MANIFEST_INSTALL_ARGS}
+                OUTPUT_VARIABLE Z_VCPKG_MANIFEST_INSTALL_LOGTEXT
+                ERROR_VARIABLE Z_VCPKG_MANIFEST_INSTALL_LOGTEXT
+                RESULT_VARIABLE Z_VCPKG_MANIFEST_INSTALL_RESULT
+                ${Z_VCPKG_MANIFEST_INSTALL_ECHO_PARAMS}
+            )
+            file(WRITE "${Z_VCPKG_MANIFEST_INSTALL_LOGFILE}" "${Z_VCPKG_MANIFEST_INSTALL_LOGTEXT}")
+            if(Z_VCPKG_MANIFEST_INSTALL_RESULT EQUAL "0" AND VCPKG_MANIFEST_INSTALL_SKIP_UNCHANGED)
+                z_vcpkg_manifest_install_fingerprint(Z_VCPKG_MANIFEST_INSTALL_FINGERPRINT ${Z_VCPKG_MANIFEST_INSTALL_ARGS})
+                file(WRITE "${Z_VCPKG_MANIFEST_INSTALL_FINGERPRINT_FILE}" "${Z_VCPKG_MANIFEST_INSTALL_FINGERPRINT}")
+            endif()
+        endif()
 
         if(Z_VCPKG_MANIFEST_INSTALL_RESULT EQUAL "0")
-            message(STATUS "Running vcpkg install - done")
+            if(Z_VCPKG_MANIFEST_INSTALL_UP_TO_DATE)
+                message(STATUS "Running vcpkg install - skipped, nothing changed since the last install")
+            else()
+                message(STATUS "Running vcpkg install - done")
+            endif()
             set_property(DIRECTORY APPEND PROPERTY CMAKE_CONFIGURE_DEPENDS
                 "${VCPKG_MANIFEST_DIR}/vcpkg.json")
             if(EXISTS "${VCPKG_MANIFEST_DIR}/vcpkg-configuration.json")
@@ -766,6 +921,257 @@ if(X_VCPKG_APPLOCAL_DEPS_INSTALL)
 endif()
 
 option(VCPKG_TRACE_FIND_PACKAGE "Trace calls to find_package()" OFF)
+option(VCPKG_PROFILE_FIND_PACKAGE "Write a report of the time spent in find_package() calls to the build directory. Requires CMake 3.23." OFF)
+if(VCPKG_PROFILE_FIND_PACKAGE AND CMAKE_VERSION VERSION_LESS "3.23")
+    message(WARNING "VCPKG_PROFILE_FIND_PACKAGE requires CMake 3.23.")
+    set(VCPKG_PROFILE_FIND_PACKAGE OFF)
+endif()
+
+cmake_policy(PUSH)
+cmake_policy(VERSION 3.16)
+
+# The find_package() profile records every call in global properties Z_VCPKG_FIND_PACKAGE_PROFILE_<id>_*:
+# the package name, arguments, calling file, parent call, vcpkg-cmake-wrapper.cmake, start and end time
+# in microseconds, and the number of files included so far. The report is written at the end of the
+# configuration of the top-level directory.
+function(z_vcpkg_find_package_profile_now out_var)
+    string(TIMESTAMP now "%s%f" UTC) # CMake 3.23
+    set("${out_var}" "${now}" PARENT_SCOPE)
+endfunction()
+
+function(z_vcpkg_find_package_profile_count_include)
+    get_property(count GLOBAL PROPERTY Z_VCPKG_FIND_PACKAGE_PROFILE_INCLUDES)
+    math(EXPR count "0${count} + 1")
+    set_property(GLOBAL PROPERTY Z_VCPKG_FIND_PACKAGE_PROFILE_INCLUDES "${count}")
+endfunction()
+
+function(z_vcpkg_find_package_profile_begin package_name)
+    get_property(id GLOBAL PROPERTY Z_VCPKG_FIND_PACKAGE_PROFILE_COUNT)
+    math(EXPR next_id "0${id} + 1")
+    set_property(GLOBAL PROPERTY Z_VCPKG_FIND_PACKAGE_PROFILE_COUNT "${next_id}")
+    set(id "${next_id}")
+    get_property(stack GLOBAL PROPERTY Z_VCPKG_FIND_PACKAGE_PROFILE_STACK)
+    set(parent "0")
+    if(NOT "${stack}" STREQUAL "")
+        list(GET stack -1 parent)
+    endif()
+    list(APPEND stack "${id}")
+    set_property(GLOBAL PROPERTY Z_VCPKG_FIND_PACKAGE_PROFILE_STACK "${stack}")
+    set_property(GLOBAL APPEND PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${parent}_CHILDREN" "${id}")
+
+    string(JOIN " " arguments ${ARGN})
+    get_property(includes GLOBAL PROPERTY Z_VCPKG_FIND_PACKAGE_PROFILE_INCLUDES)
+    file(RELATIVE_PATH caller "${CMAKE_SOURCE_DIR}" "${CMAKE_CURRENT_LIST_FILE}")
+    set_property(GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_NAME" "${package_name}")
+    set_property(GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_ARGUMENTS" "${arguments}")
+    set_property(GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_CALLER" "${caller}")
+    set_property(GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_INCLUDES" "0${includes}")
+    z_vcpkg_find_package_profile_now(now)
+    set_property(GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_START" "${now}")
+endfunction()
+
+function(z_vcpkg_find_package_profile_wrapper wrapper_path)
+    get_property(stack GLOBAL PROPERTY Z_VCPKG_FIND_PACKAGE_PROFILE_STACK)
+    list(GET stack -1 id)
+    file(RELATIVE_PATH wrapper "${_VCPKG_INSTALLED_DIR}/${VCPKG_TARGET_TRIPLET}" "${wrapper_path}")
+    set_property(GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_WRAPPER" "${wrapper}")
+endfunction()
+
+function(z_vcpkg_find_package_profile_end)
+    z_vcpkg_find_package_profile_now(now)
+    get_property(stack GLOBAL PROPERTY Z_VCPKG_FIND_PACKAGE_PROFILE_STACK)
+    list(GET stack -1 id)
+    list(REMOVE_AT stack -1)
+    set_property(GLOBAL PROPERTY Z_VCPKG_FIND_PACKAGE_PROFILE_STACK "${stack}")
+
+    get_property(package_name GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_NAME")
+    # The configuration file of a package is not loaded by include().
+    if(NOT "${${package_name}_CONFIG}" STREQUAL "")
+        z_vcpkg_find_package_profile_count_include()
+    endif()
+    get_property(start GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_START")
+    get_property(includes_start GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_INCLUDES")
+    get_property(includes GLOBAL PROPERTY Z_VCPKG_FIND_PACKAGE_PROFILE_INCLUDES)
+    math(EXPR total "${now} - ${start}")
+    math(EXPR includes "0${includes} - ${includes_start}")
+    set_property(GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_TOTAL" "${total}")
+    set_property(GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_INCLUDES" "${includes}")
+    string(TOUPPER "${package_name}" upper_package_name)
+    set(found false)
+    if(${package_name}_FOUND OR ${upper_package_name}_FOUND)
+        set(found true)
+    endif()
+    set_property(GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_FOUND" "${found}")
+endfunction()
+
+function(z_vcpkg_find_package_profile_json_string out_var value)
+    string(REPLACE "\\" "\\\\" value "${value}")
+    string(REPLACE "\"" "\\\"" value "${value}")
+    set("${out_var}" "\"${value}\"" PARENT_SCOPE)
+endfunction()
+
+function(z_vcpkg_find_package_profile_ms out_var microseconds)
+    math(EXPR whole "${microseconds} / 1000")
+    math(EXPR tenths "${microseconds} % 1000 / 100")
+    set("${out_var}" "${whole}.${tenths}" PARENT_SCOPE)
+endfunction()
+
+# Sets out_var to the ids in ARGN, sorted by descending value of the given property.
+function(z_vcpkg_find_package_profile_sort out_var property)
+    set(keys "")
+    foreach(id IN LISTS ARGN)
+        get_property(value GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_${property}")
+        string(LENGTH "${value}" length)
+        math(EXPR padding "20 - ${length}")
+        string(REPEAT "0" "${padding}" zeros)
+        list(APPEND keys "${zeros}${value}:${id}")
+    endforeach()
+    list(SORT keys ORDER DESCENDING)
+    list(TRANSFORM keys REPLACE "^[0-9]+:" "")
+    set("${out_var}" "${keys}" PARENT_SCOPE)
+endfunction()
+
+# Appends the calls below parent to the text and JSON report, and computes their self time.
+function(z_vcpkg_find_package_profile_report_calls text_var json_var parent depth)
+    get_property(children GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${parent}_CHILDREN")
+    set(text "${${text_var}}")
+    set(json_calls "")
+    z_vcpkg_find_package_profile_sort(children TOTAL ${children})
+    foreach(id IN LISTS children)
+        get_property(total GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_TOTAL")
+        if("${total}" STREQUAL "")
+            continue()
+        endif()
+        foreach(field IN ITEMS NAME ARGUMENTS CALLER WRAPPER INCLUDES FOUND)
+            get_property("${field}" GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_${field}")
+        endforeach()
+        set(self "${total}")
+        get_property(grandchildren GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_CHILDREN")
+        foreach(grandchild IN LISTS grandchildren)
+            get_property(grandchild_total GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${grandchild}_TOTAL")
+            math(EXPR self "${self} - 0${grandchild_total}")
+        endforeach()
+        set_property(GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_SELF" "${self}")
+
+        z_vcpkg_find_package_profile_ms(total_ms "${total}")
+        z_vcpkg_find_package_profile_ms(self_ms "${self}")
+        string(REPEAT "  " "${depth}" indent)
+        set(line "${total_ms}          ")
+        string(SUBSTRING "${line}" 0 10 line)
+        set(self_column "${self_ms}          ")
+        string(SUBSTRING "${self_column}" 0 10 self_column)
+        set(includes_column "${INCLUDES}        ")
+        string(SUBSTRING "${includes_column}" 0 8 includes_column)
+        string(STRIP "${NAME} ${ARGUMENTS}" call)
+        string(APPEND line "${self_column}${includes_column}${indent}${call}")
+        if(NOT "${WRAPPER}" STREQUAL "")
+            string(APPEND line " [${WRAPPER}]")
+        endif()
+        if(NOT FOUND)
+            string(APPEND line " (not found)")
+        endif()
+        string(APPEND text "${line}\n")
+
+        set(nested_text "")
+        set(nested_json "")
+        math(EXPR nested_depth "${depth} + 1")
+        z_vcpkg_find_package_profile_report_calls(nested_text nested_json "${id}" "${nested_depth}")
+        string(APPEND text "${nested_text}")
+
+        set(json "{")
+        foreach(key field IN ZIP_LISTS Z_VCPKG_FIND_PACKAGE_PROFILE_JSON_KEYS Z_VCPKG_FIND_PACKAGE_PROFILE_JSON_FIELDS)
+            z_vcpkg_find_package_profile_json_string(value "${${field}}")
+            string(APPEND json "\"${key}\": ${value}, ")
+        endforeach()
+        string(APPEND json "\"found\": ${FOUND}, \"included_files\": ${INCLUDES}, \"total_us\": ${total}, \"self_us\": ${self}, \"calls\": [${nested_json}]}")
+        list(APPEND json_calls "${json}")
+    endforeach()
+    list(JOIN json_calls ", " json_calls)
+    set("${text_var}" "${text}" PARENT_SCOPE)
+    set("${json_var}" "${json_calls}" PARENT_SCOPE)
+endfunction()
+set(Z_VCPKG_FIND_PACKAGE_PROFILE_JSON_KEYS package arguments caller vcpkg_cmake_wrapper)
+set(Z_VCPKG_FIND_PACKAGE_PROFILE_JSON_FIELDS NAME ARGUMENTS CALLER WRAPPER)
+
+function(z_vcpkg_find_package_profile_report)
+    set(calls_text "")
+    set(calls_json "")
+    z_vcpkg_find_package_profile_report_calls(calls_text calls_json 0 0)
+
+    # The self time of all calls of a package is what it costs.
+    get_property(count GLOBAL PROPERTY Z_VCPKG_FIND_PACKAGE_PROFILE_COUNT)
+    set(packages "")
+    set(total 0)
+    if(NOT "${count}" STREQUAL "")
+        foreach(id RANGE 1 "${count}")
+            get_property(self GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_SELF")
+            if("${self}" STREQUAL "")
+                continue()
+            endif()
+            get_property(package_name GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_NAME")
+            get_property(includes GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${id}_INCLUDES")
+            string(MAKE_C_IDENTIFIER "package_${package_name}" key)
+            get_property(package_self GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${key}_SELF")
+            get_property(package_calls GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${key}_CALLS")
+            if("${package_calls}" STREQUAL "")
+                list(APPEND packages "${key}")
+                set_property(GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${key}_NAME" "${package_name}")
+            endif()
+            math(EXPR package_self "0${package_self} + ${self}")
+            math(EXPR package_calls "0${package_calls} + 1")
+            math(EXPR total "${total} + ${self}")
+            set_property(GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${key}_SELF" "${package_self}")
+            set_property(GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${key}_CALLS" "${package_calls}")
+        endforeach()
+    endif()
+    z_vcpkg_find_package_profile_sort(packages SELF ${packages})
+    set(packages_text "")
+    set(packages_json "")
+    foreach(key IN LISTS packages)
+        foreach(field IN ITEMS NAME SELF CALLS)
+            get_property("${field}" GLOBAL PROPERTY "Z_VCPKG_FIND_PACKAGE_PROFILE_${key}_${field}")
+        endforeach()
+        z_vcpkg_find_package_profile_ms(self_ms "${SELF}")
+        set(line "${self_ms}          ")
+        string(SUBSTRING "${line}" 0 10 line)
+        set(calls_column "${CALLS}        ")
+        string(SUBSTRING "${calls_column}" 0 8 calls_column)
+        string(APPEND packages_text "${line}${calls_column}${NAME}\n")
+        z_vcpkg_find_package_profile_json_string(package_json "${NAME}")
+        list(APPEND packages_json "{\"package\": ${package_json}, \"calls\": ${CALLS}, \"self_us\": ${SELF}}")
+    endforeach()
+    list(JOIN packages_json ", " packages_json)
+
+    z_vcpkg_find_package_profile_ms(total_ms "${total}")
+    set(report_file "${CMAKE_BINARY_DIR}/vcpkg-find-package-profile")
+    file(WRITE "${report_file}.txt"
+        "find_package() calls, ${total_ms} ms in total\n\n"
+        "Packages by self time:\n"
+        "self ms   calls   package\n"
+        "${packages_text}\n"
+        "Calls by total time:\n"
+        "total ms  self ms   files   call\n"
+        "${calls_text}"
+    )
+    file(WRITE "${report_file}.json" "{\"total_us\": ${total}, \"packages\": [${packages_json}], \"calls\": [${calls_json}]}\n")
+    message(STATUS "find_package() profile: ${total_ms} ms, see ${report_file}.txt")
+endfunction()
+
+if(VCPKG_PROFILE_FIND_PACKAGE)
+    # Counts the files included within find_package() calls.
+    macro(include)
+        z_vcpkg_find_package_profile_count_include()
+        _include(${ARGV})
+    endmacro()
+    get_property(Z_VCPKG_FIND_PACKAGE_PROFILE_DEFERRED GLOBAL PROPERTY Z_VCPKG_FIND_PACKAGE_PROFILE_DEFERRED)
+    if(NOT Z_VCPKG_CMAKE_IN_TRY_COMPILE AND NOT Z_VCPKG_FIND_PACKAGE_PROFILE_DEFERRED)
+        set_property(GLOBAL PROPERTY Z_VCPKG_FIND_PACKAGE_PROFILE_DEFERRED ON)
+        cmake_language(DEFER DIRECTORY "${CMAKE_SOURCE_DIR}" CALL z_vcpkg_find_package_profile_report)
+    endif()
+endif()
+
+cmake_policy(POP)
+
 if(NOT DEFINED VCPKG_OVERRIDE_FIND_PACKAGE_NAME)
     set(VCPKG_OVERRIDE_FIND_PACKAGE_NAME find_package)
 endif()
@@ -786,6 +1192,9 @@ macro("${VCPKG_OVERRIDE_FIND_PACKAGE_NAME}" z_vcpkg_find_package_package_name)
     set(z_vcpkg_find_package_package_name "${z_vcpkg_find_package_package_name}")
     set(z_vcpkg_find_package_${z_vcpkg_find_package_backup_id}_ARGN "${ARGN}")
     set(z_vcpkg_find_package_${z_vcpkg_find_package_backup_id}_backup_vars "")
+    if(VCPKG_PROFILE_FIND_PACKAGE)
+        z_vcpkg_find_package_profile_begin("${z_vcpkg_find_package_package_name}" ${ARGN})
+    endif()
 
     if(z_vcpkg_find_package_backup_id EQUAL "1")
         # This is the top-level find_package call
@@ -842,6 +1251,9 @@ macro("${VCPKG_OVERRIDE_FIND_PACKAGE_NAME}" z_vcpkg_find_package_package_name)
             message(STATUS "${z_vcpkg_find_package_indent}using share/${z_vcpkg_find_package_lowercase_package_name}/vcpkg-cmake-wrapper.cmake")
             unset(z_vcpkg_find_package_indent)
         endif()
+        if(VCPKG_PROFILE_FIND_PACKAGE)
+            z_vcpkg_find_package_profile_wrapper("${z_vcpkg_find_package_vcpkg_cmake_wrapper_path}")
+        endif()
         list(APPEND z_vcpkg_find_package_${z_vcpkg_find_package_backup_id}_backup_vars "ARGS")
         if(DEFINED ARGS)
             set(z_vcpkg_find_package_${z_vcpkg_find_package_backup_id}_backup_ARGS "${ARGS}")
@@ -905,6 +1317,9 @@ macro("${VCPKG_OVERRIDE_FIND_PACKAGE_NAME}" z_vcpkg_find_package_package_name)
         endif()
         unset("z_vcpkg_find_package_${z_vcpkg_find_package_backup_id}_backup_${z_vcpkg_find_package_${z_vcpkg_find_package_backup_id}_backup_var}")
     endforeach()
+    if(VCPKG_PROFILE_FIND_PACKAGE)
+        z_vcpkg_find_package_profile_end()
+    endif()
     math(EXPR z_vcpkg_find_package_backup_id "${z_vcpkg_find_package_backup_id} - 1")
     if(z_vcpkg_find_package_backup_id LESS "0")
         message(FATAL_ERROR "[vcpkg]: find_package ended with z_vcpkg_find_package_backup_id being less than 0! This is a logical error and should never happen. Please provide a cmake trace log via cmake cmd line option '--trace-expand'!")
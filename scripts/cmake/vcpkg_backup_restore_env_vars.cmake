@@ -33,3 +33,26 @@ function(vcpkg_restore_env_variables)
         endif()
     endforeach()
 endfunction()
+
+# Sets out_var to CMake code which restores the current values of the environment variables VARS,
+# e.g. in a script running a process after the environment of the port has changed.
+function(z_vcpkg_snapshot_env_variables out_var)
+    cmake_parse_arguments(PARSE_ARGV 1 arg "" "" "VARS")
+    if(NOT DEFINED arg_VARS)
+        message(FATAL_ERROR "VARS must be defined.")
+    endif()
+    if(DEFINED arg_UNPARSED_ARGUMENTS)
+        message(FATAL_ERROR "${CMAKE_CURRENT_FUNCTION} was passed extra arguments: ${arg_UNPARSED_ARGUMENTS}")
+    endif()
+
+    set(snapshot "")
+    list(REMOVE_DUPLICATES arg_VARS)
+    foreach(envvar IN LISTS arg_VARS)
+        if(DEFINED ENV{${envvar}})
+            string(APPEND snapshot "set(\"ENV{${envvar}}\" [==[$ENV{${envvar}}]==])\n")
+        else()
+            string(APPEND snapshot "unset(\"ENV{${envvar}}\")\n")
+        endif()
+    endforeach()
+    set("${out_var}" "${snapshot}" PARENT_SCOPE)
+endfunction()
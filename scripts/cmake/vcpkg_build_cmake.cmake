@@ -1,4 +1,5 @@
 function(vcpkg_build_cmake)
+    z_vcpkg_profile_begin(build vcpkg_build_cmake)
     cmake_parse_arguments(PARSE_ARGV 0 "arg"
         "DISABLE_PARALLEL;ADD_BIN_TO_PATH"
         "TARGET;LOGFILE_ROOT"
@@ -45,7 +46,20 @@ function(vcpkg_build_cmake)
         vcpkg_list(SET target_param "--target" "${arg_TARGET}")
     endif()
 
-    foreach(build_type IN ITEMS debug release)
+    set(parallel_options "")
+    foreach(option IN ITEMS DISABLE_PARALLEL ADD_BIN_TO_PATH)
+        if(arg_${option})
+            list(APPEND parallel_options "${option}")
+        endif()
+    endforeach()
+    z_vcpkg_cmake_build_configs_in_parallel(build_types
+        LOGFILE_BASE "${arg_LOGFILE_ROOT}"
+        ${parallel_options}
+        TARGET_ARGS ${target_param}
+        BUILD_TOOL_ARGS ${build_param}
+    )
+
+    foreach(build_type IN LISTS build_types)
         if(NOT DEFINED VCPKG_BUILD_TYPE OR "${VCPKG_BUILD_TYPE}" STREQUAL "${build_type}")
             if("${build_type}" STREQUAL "debug")
                 set(short_build_type "dbg")
@@ -92,4 +106,5 @@ function(vcpkg_build_cmake)
             endif()
         endif()
     endforeach()
+    z_vcpkg_profile_end(vcpkg_build_cmake)
 endfunction()
@@ -1,4 +1,5 @@
 function(vcpkg_build_make)
+    z_vcpkg_profile_begin(build vcpkg_build_make)
     z_vcpkg_get_cmake_vars(cmake_vars_file)
     include("${cmake_vars_file}")
 
@@ -190,4 +191,5 @@ function(vcpkg_build_make)
 
     vcpkg_restore_env_variables(VARS LIB LIBPATH LIBRARY_PATH LD_LIBRARY_PATH CPPFLAGS CFLAGS CXXFLAGS RCFLAGS)
     unset(_VCPKG_MAKE_NO_DEBUG PARENT_SCOPE)
+    z_vcpkg_profile_end(vcpkg_build_make)
 endfunction()
@@ -9,6 +9,7 @@ endfunction()
 
 
 function(vcpkg_build_ninja)
+    z_vcpkg_profile_begin(build vcpkg_build_ninja)
     cmake_parse_arguments(PARSE_ARGV 0 arg "" "" "TARGETS")
 
     if(DEFINED arg_UNPARSED_ARGUMENTS)
@@ -27,4 +28,5 @@ function(vcpkg_build_ninja)
     if(NOT DEFINED VCPKG_BUILD_TYPE OR VCPKG_BUILD_TYPE STREQUAL "release")
         z_vcpkg_build_ninja_build("${TARGET_TRIPLET}-rel" "${arg_TARGETS}")
     endif()
+    z_vcpkg_profile_end(vcpkg_build_ninja)
 endfunction()
@@ -1,4 +1,5 @@
 function(vcpkg_build_nmake)
+    z_vcpkg_profile_begin(build vcpkg_build_nmake)
     cmake_parse_arguments(PARSE_ARGV 0 arg
         "ADD_BIN_TO_PATH;ENABLE_INSTALL;NO_DEBUG;PREFER_JOM"
         "SOURCE_PATH;PROJECT_SUBPATH;PROJECT_NAME;LOGFILE_ROOT;CL_LANGUAGE"
@@ -163,4 +164,5 @@ function(vcpkg_build_nmake)
             vcpkg_restore_env_variables(VARS _CL_ LINK)
         endif()
     endforeach()
+    z_vcpkg_profile_end(vcpkg_build_nmake)
 endfunction()
@@ -9,6 +9,7 @@ function(z_run_jom_build invoke_command targets log_prefix log_suffix)
 endfunction()
 
 function(vcpkg_build_qmake)
+    z_vcpkg_profile_begin(build vcpkg_build_qmake)
     # parse parameters such that semicolons in options arguments to COMMAND don't get erased
     cmake_parse_arguments(PARSE_ARGV 0 arg
         "SKIP_MAKEFILES"
@@ -79,4 +80,5 @@ function(vcpkg_build_qmake)
     endforeach()
 
     vcpkg_restore_env_variables(VARS CL _CL_)
+    z_vcpkg_profile_end(vcpkg_build_qmake)
 endfunction()
@@ -87,6 +87,7 @@ endfunction()
 
 
 function(vcpkg_configure_cmake)
+    z_vcpkg_profile_begin(configure vcpkg_configure_cmake)
     cmake_parse_arguments(PARSE_ARGV 0 arg
         "PREFER_NINJA;DISABLE_PARALLEL_CONFIGURE;NO_CHARSET_FLAG;Z_GET_CMAKE_VARS_USAGE"
         "SOURCE_PATH;GENERATOR;LOGNAME"
@@ -173,6 +174,20 @@ function(vcpkg_configure_cmake)
         vcpkg_add_to_path("${ninja_path}")
         vcpkg_list(APPEND arg_OPTIONS "-DCMAKE_MAKE_PROGRAM=${NINJA}")
     endif()
+    if("${generator}" STREQUAL "Ninja")
+        if(DEFINED VCPKG_LINK_CONCURRENCY)
+            # Cap the number of concurrent link jobs, unless the port defines its own job pools.
+            set(port_job_pools OFF)
+            foreach(option IN LISTS arg_OPTIONS arg_OPTIONS_RELEASE arg_OPTIONS_DEBUG)
+                if(option MATCHES "^-DCMAKE_JOB_POOL")
+                    set(port_job_pools ON)
+                endif()
+            endforeach()
+            if(NOT port_job_pools)
+                vcpkg_list(APPEND arg_OPTIONS "-DCMAKE_JOB_POOLS=vcpkg_link=${VCPKG_LINK_CONCURRENCY}" "-DCMAKE_JOB_POOL_LINK=vcpkg_link")
+            endif()
+        endif()
+    endif()
 
     file(REMOVE_RECURSE
         "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-rel"
@@ -249,6 +264,19 @@ function(vcpkg_configure_cmake)
         "-D_VCPKG_INSTALLED_DIR=${_VCPKG_INSTALLED_DIR}"
         "-DVCPKG_MANIFEST_INSTALL=OFF"
     )
+    if(DEFINED VCPKG_TARGET_ISA_LEVEL)
+        vcpkg_list(APPEND arg_OPTIONS "-DVCPKG_TARGET_ISA_LEVEL=${VCPKG_TARGET_ISA_LEVEL}")
+    endif()
+    if(DEFINED VCPKG_ENABLE_LTO)
+        vcpkg_list(APPEND arg_OPTIONS "-DVCPKG_ENABLE_LTO=${VCPKG_ENABLE_LTO}")
+    endif()
+    if(DEFINED VCPKG_LTO_CACHE_DIR)
+        vcpkg_list(APPEND arg_OPTIONS "-DVCPKG_LTO_CACHE_DIR=${VCPKG_LTO_CACHE_DIR}")
+    endif()
+    if(DEFINED VCPKG_COMPILER_LAUNCHER)
+        list(JOIN VCPKG_COMPILER_LAUNCHER "\;" compiler_launcher_string)
+        vcpkg_list(APPEND arg_OPTIONS "-DVCPKG_COMPILER_LAUNCHER=${compiler_launcher_string}")
+    endif()
 
     if(NOT "${generator_arch}" STREQUAL "")
         vcpkg_list(APPEND arg_OPTIONS "-A${generator_arch}")
@@ -392,4 +420,5 @@ If these options should still be passed for whatever reason, please use the `MAY
     if(NOT arg_Z_GET_CMAKE_VARS_USAGE)
         set(Z_VCPKG_CMAKE_GENERATOR "${generator}" PARENT_SCOPE)
     endif()
+    z_vcpkg_profile_end(vcpkg_configure_cmake)
 endfunction()
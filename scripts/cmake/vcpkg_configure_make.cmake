@@ -231,10 +231,24 @@ macro(z_vcpkg_append_to_configure_environment inoutstring var defaultval)
     endif()
 endmacro()
 
+# Post-processes the configured build tree in target_dir and stores its autoconf results.
+function(z_vcpkg_configure_make_finish_config target_dir autoconf_cache_key)
+    z_vcpkg_autoconf_cache_store(KEY "${autoconf_cache_key}" WORKING_DIRECTORY "${target_dir}")
+    if(VCPKG_TARGET_IS_WINDOWS AND NOT VCPKG_TARGET_IS_MINGW AND VCPKG_LIBRARY_LINKAGE STREQUAL dynamic)
+        file(GLOB_RECURSE libtool_files "${target_dir}*/libtool")
+        foreach(lt_file IN LISTS libtool_files)
+            file(READ "${lt_file}" _contents)
+            string(REPLACE ".dll.lib" ".lib" _contents "${_contents}")
+            file(WRITE "${lt_file}" "${_contents}")
+        endforeach()
+    endif()
+endfunction()
+
 function(vcpkg_configure_make)
+    z_vcpkg_profile_begin(configure vcpkg_configure_make)
     # parse parameters such that semicolons in options arguments to COMMAND don't get erased
     cmake_parse_arguments(PARSE_ARGV 0 arg
-        "AUTOCONFIG;SKIP_CONFIGURE;COPY_SOURCE;DISABLE_VERBOSE_FLAGS;NO_ADDITIONAL_PATHS;ADD_BIN_TO_PATH;NO_DEBUG;USE_WRAPPERS;NO_WRAPPERS;DETERMINE_BUILD_TRIPLET"
+        "AUTOCONFIG;SKIP_CONFIGURE;COPY_SOURCE;DISABLE_VERBOSE_FLAGS;NO_ADDITIONAL_PATHS;ADD_BIN_TO_PATH;NO_DEBUG;USE_WRAPPERS;NO_WRAPPERS;DETERMINE_BUILD_TRIPLET;DISABLE_PARALLEL_CONFIGURE"
         "SOURCE_PATH;PROJECT_SUBPATH;PRERUN_SHELL;BUILD_TRIPLET"
         "OPTIONS;OPTIONS_DEBUG;OPTIONS_RELEASE;CONFIGURE_ENVIRONMENT_VARIABLES;CONFIG_DEPENDENT_ENVIRONMENT;ADDITIONAL_MSYS_PACKAGES"
     )
@@ -561,6 +575,10 @@ function(vcpkg_configure_make)
                 if(ARGN)
                     string(APPEND prog " ${ARGN}")
                 endif()
+                if(envvar MATCHES "^(CC|CXX)(_FOR_BUILD)?$" AND NOT "${VCPKG_COMPILER_LAUNCHER}" STREQUAL "")
+                    list(JOIN VCPKG_COMPILER_LAUNCHER " " compiler_launcher)
+                    set(prog "${compiler_launcher} ${prog}")
+                endif()
                 set(z_vcm_all_tools "${z_vcm_all_tools}" PARENT_SCOPE)
                 set(ENV{${envvar}} "${prog}")
             endif()
@@ -795,15 +813,29 @@ function(vcpkg_configure_make)
         vcpkg_list(JOIN tmp " " "${var}")
     endforeach()
 
+    # The environment variables which are set differently for each configuration.
+    set(config_env_vars
+        ${arg_CONFIG_DEPENDENT_ENVIRONMENT}
+        CPPFLAGS CPPFLAGS_FOR_BUILD CFLAGS CFLAGS_FOR_BUILD CXXFLAGS RCFLAGS LDFLAGS LDFLAGS_FOR_BUILD ARFLAGS
+        CC CC_FOR_BUILD _LINK_ LIB LIBPATH LIBRARY_PATH PATH PKG_CONFIG PKG_CONFIG_PATH
+    )
+
+    # configure scripts are single-threaded, so the configurations are configured concurrently.
+    set(configure_in_parallel OFF)
+    list(LENGTH all_buildtypes buildtype_count)
+    if(NOT arg_DISABLE_PARALLEL_CONFIGURE AND NOT arg_SKIP_CONFIGURE AND buildtype_count GREATER "1" AND VCPKG_CONCURRENCY GREATER "1")
+        z_vcpkg_execute_build_process_parallel_supported(configure_in_parallel)
+    endif()
+    set(parallel_configs "")
+
     foreach(current_buildtype IN LISTS all_buildtypes)
-        foreach(ENV_VAR ${arg_CONFIG_DEPENDENT_ENVIRONMENT})
-            if(DEFINED ENV{${ENV_VAR}})
-                set(backup_config_${ENV_VAR} "$ENV{${ENV_VAR}}")
-            endif()
+        z_vcpkg_snapshot_env_variables(env_before_config VARS ${config_env_vars})
+        foreach(ENV_VAR IN LISTS arg_CONFIG_DEPENDENT_ENVIRONMENT)
             set(ENV{${ENV_VAR}} "${${ENV_VAR}_${current_buildtype}}")
         endforeach()
 
-        set(target_dir "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-${short_name_${current_buildtype}}")
+        set(short_name "${short_name_${current_buildtype}}")
+        set(target_dir "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-${short_name}")
         file(MAKE_DIRECTORY "${target_dir}")
         file(RELATIVE_PATH relative_build_path "${target_dir}" "${src_dir}")
 
@@ -837,10 +869,7 @@ function(vcpkg_configure_make)
         endif()
 
         if(LINK_ENV_${current_buildtype})
-            set(link_config_backup "$ENV{_LINK_}")
             set(ENV{_LINK_} "${LINK_ENV_${current_buildtype}}")
-        else()
-            unset(link_config_backup)
         endif()
 
         vcpkg_list(APPEND lib_env_vars LIB LIBPATH LIBRARY_PATH) # LD_LIBRARY_PATH)
@@ -854,48 +883,75 @@ function(vcpkg_configure_make)
         endforeach()
         unset(lib_env_vars)
 
-        set(command "${base_cmd}" -c "${configure_env} ./${relative_build_path}/configure ${arg_BUILD_TRIPLET} ${arg_OPTIONS} ${arg_OPTIONS_${current_buildtype}}")
+        set(autoconf_cache_options "")
+        if(NOT arg_SKIP_CONFIGURE)
+            z_vcpkg_autoconf_cache_key("autoconf_cache_key_${short_name}"
+                CONFIG "${current_buildtype}"
+                CONFIGURE_SCRIPT "${target_dir}/${relative_build_path}/configure"
+                CONFIGURE_ENV "${configure_env}"
+                OPTIONS ${arg_BUILD_TRIPLET} ${arg_OPTIONS} ${arg_OPTIONS_${current_buildtype}}
+            )
+            z_vcpkg_autoconf_cache_restore(KEY "${autoconf_cache_key_${short_name}}" WORKING_DIRECTORY "${target_dir}" OUT_OPTIONS_VAR autoconf_cache_options)
+        endif()
+
+        set(command "${base_cmd}" -c "${configure_env} ./${relative_build_path}/configure ${arg_BUILD_TRIPLET} ${arg_OPTIONS} ${arg_OPTIONS_${current_buildtype}} ${autoconf_cache_options}")
         
         if(arg_ADD_BIN_TO_PATH)
-            set(path_backup $ENV{PATH})
             vcpkg_add_to_path("${CURRENT_INSTALLED_DIR}${path_suffix_${current_buildtype}}/bin")
         endif()
         debug_message("Configure command:'${command}'")
-        if (NOT arg_SKIP_CONFIGURE)
-            message(STATUS "Configuring ${TARGET_TRIPLET}-${short_name_${current_buildtype}}")
+        if(configure_in_parallel)
+            set("${short_name}_command" ${command})
+            set("${short_name}_working_directory" "${target_dir}")
+            set("${short_name}_logname" "config-${TARGET_TRIPLET}-${short_name}")
+            z_vcpkg_snapshot_env_variables("${short_name}_environment" VARS ${config_env_vars})
+            list(APPEND parallel_configs "${short_name}")
+        elseif(NOT arg_SKIP_CONFIGURE)
+            message(STATUS "Configuring ${TARGET_TRIPLET}-${short_name}")
             vcpkg_execute_required_process(
                 COMMAND ${command}
                 WORKING_DIRECTORY "${target_dir}"
-                LOGNAME "config-${TARGET_TRIPLET}-${short_name_${current_buildtype}}"
+                LOGNAME "config-${TARGET_TRIPLET}-${short_name}"
                 SAVE_LOG_FILES config.log
             )
-            if(VCPKG_TARGET_IS_WINDOWS AND NOT VCPKG_TARGET_IS_MINGW AND VCPKG_LIBRARY_LINKAGE STREQUAL dynamic)
-                file(GLOB_RECURSE libtool_files "${target_dir}*/libtool")
-                foreach(lt_file IN LISTS libtool_files)
-                    file(READ "${lt_file}" _contents)
-                    string(REPLACE ".dll.lib" ".lib" _contents "${_contents}")
-                    file(WRITE "${lt_file}" "${_contents}")
-                endforeach()
-            endif()
+            z_vcpkg_configure_make_finish_config("${target_dir}" "${autoconf_cache_key_${short_name}}")
         endif()
         z_vcpkg_restore_pkgconfig_path()
-        
-        if(DEFINED link_config_backup)
-            set(ENV{_LINK_} "${link_config_backup}")
-        endif()
-        
-        if(arg_ADD_BIN_TO_PATH)
-            set(ENV{PATH} "${path_backup}")
-        endif()
+
         # Restore environment (config dependent)
-        foreach(ENV_VAR IN LISTS ${arg_CONFIG_DEPENDENT_ENVIRONMENT})
-            if(backup_config_${ENV_VAR})
-                set(ENV{${ENV_VAR}} "${backup_config_${ENV_VAR}}")
-            else()
-                unset(ENV{${ENV_VAR}})
+        cmake_language(EVAL CODE "${env_before_config}")
+    endforeach()
+
+    if(configure_in_parallel)
+        list(TRANSFORM parallel_configs PREPEND "${TARGET_TRIPLET}-" OUTPUT_VARIABLE parallel_config_names)
+        list(JOIN parallel_config_names " and " parallel_config_names)
+        message(STATUS "Configuring ${parallel_config_names} in parallel")
+        z_vcpkg_execute_build_process_parallel(
+            PROCESSES ${parallel_configs}
+            WORKING_DIRECTORY "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-parallel-configure"
+            LOGNAME "config-${TARGET_TRIPLET}-parallel"
+            OUT_FAILED_VAR failed_configs
+        )
+        foreach(short_name IN LISTS parallel_configs)
+            set(target_dir "${${short_name}_working_directory}")
+            if(short_name IN_LIST failed_configs)
+                # Configure again on its own to report the failure with the usual logs.
+                message(STATUS "Parallel configure failed for ${TARGET_TRIPLET}-${short_name}; configuring again on its own")
+                z_vcpkg_snapshot_env_variables(env_before_config VARS ${config_env_vars})
+                cmake_language(EVAL CODE "${${short_name}_environment}")
+                vcpkg_execute_required_process(
+                    COMMAND ${${short_name}_command}
+                    WORKING_DIRECTORY "${target_dir}"
+                    LOGNAME "${${short_name}_logname}"
+                    SAVE_LOG_FILES config.log
+                )
+                cmake_language(EVAL CODE "${env_before_config}")
+            elseif(EXISTS "${target_dir}/config.log")
+                configure_file("${target_dir}/config.log" "${CURRENT_BUILDTREES_DIR}/${${short_name}_logname}-config.log" COPYONLY)
             endif()
+            z_vcpkg_configure_make_finish_config("${target_dir}" "${autoconf_cache_key_${short_name}}")
         endforeach()
-    endforeach()
+    endif()
 
     # Export matching make program for vcpkg_build_make (cache variable)
     if(CMAKE_HOST_WIN32 AND MSYS_ROOT)
@@ -912,4 +968,5 @@ function(vcpkg_configure_make)
     set(_VCPKG_PROJECT_SOURCE_PATH ${arg_SOURCE_PATH} PARENT_SCOPE)
     set(_VCPKG_PROJECT_SUBPATH ${arg_PROJECT_SUBPATH} PARENT_SCOPE)
     set(_VCPKG_MAKE_NO_DEBUG ${arg_NO_DEBUG} PARENT_SCOPE)
+    z_vcpkg_profile_end(vcpkg_configure_make)
 endfunction()
@@ -39,6 +39,9 @@ function(z_vcpkg_meson_set_proglist_variables config_type)
                     z_vcpkg_meson_convert_compiler_flags_to_list(${prog}flags "${VCPKG_DETECTED_CMAKE_${prog}_FLAGS_${config_type}}")
                 endif()
                 list(PREPEND ${prog}flags "${VCPKG_DETECTED_CMAKE_${prog}_COMPILER}")
+                if(prog MATCHES "^(C|CXX|OBJC|OBJCXX)$")
+                    list(PREPEND ${prog}flags ${VCPKG_COMPILER_LAUNCHER})
+                endif()
                 list(FILTER ${prog}flags EXCLUDE REGEX "(-|/)nologo") # Breaks compiler detection otherwise
                 z_vcpkg_meson_convert_list_to_python_array(${prog}flags ${${prog}flags})
                 set("${var_to_set}" "${meson_${prog}} = ${${prog}flags}" PARENT_SCOPE)
@@ -52,6 +55,9 @@ function(z_vcpkg_meson_set_proglist_variables config_type)
                     z_vcpkg_meson_convert_compiler_flags_to_list(${prog}flags "${VCPKG_DETECTED_CMAKE_${prog}_FLAGS_${config_type}}")
                 endif()
                 list(PREPEND ${prog}flags "${VCPKG_DETECTED_CMAKE_${prog}_COMPILER}")
+                if(prog MATCHES "^(C|CXX|OBJC|OBJCXX)$")
+                    list(PREPEND ${prog}flags ${VCPKG_COMPILER_LAUNCHER})
+                endif()
                 list(FILTER ${prog}flags EXCLUDE REGEX "(-|/)nologo") # Breaks compiler detection otherwise
                 z_vcpkg_meson_convert_list_to_python_array(${prog}flags ${${prog}flags})
                 string(TOLOWER "${prog}" proglower)
@@ -297,10 +303,25 @@ function(z_vcpkg_meson_setup_variables config_type)
     endforeach()
 endfunction()
 
+# Copies the log files in ARGN of the configure run in target_dir next to the other logs of logname,
+# like the SAVE_LOG_FILES option of vcpkg_execute_required_process.
+function(z_vcpkg_meson_save_log_files target_dir logname)
+    foreach(log_file IN LISTS ARGN)
+        if(EXISTS "${target_dir}/${log_file}")
+            cmake_path(GET log_file FILENAME log_file_name)
+            if(NOT log_file_name MATCHES "[.]log\$")
+                string(APPEND log_file_name ".log")
+            endif()
+            configure_file("${target_dir}/${log_file}" "${CURRENT_BUILDTREES_DIR}/${logname}-${log_file_name}" COPYONLY)
+        endif()
+    endforeach()
+endfunction()
+
 function(vcpkg_configure_meson)
+    z_vcpkg_profile_begin(configure vcpkg_configure_meson)
     # parse parameters such that semicolons in options arguments to COMMAND don't get erased
     cmake_parse_arguments(PARSE_ARGV 0 arg
-        "NO_PKG_CONFIG"
+        "NO_PKG_CONFIG;DISABLE_PARALLEL_CONFIGURE"
         "SOURCE_PATH"
         "OPTIONS;OPTIONS_DEBUG;OPTIONS_RELEASE;LANGUAGES;ADDITIONAL_BINARIES;ADDITIONAL_NATIVE_BINARIES;ADDITIONAL_CROSS_BINARIES"
     )
@@ -357,6 +378,10 @@ function(vcpkg_configure_meson)
     endif()
 
     vcpkg_list(APPEND arg_OPTIONS --backend ninja --wrap-mode nodownload -Dbuildtype=plain)
+    if(DEFINED VCPKG_LINK_CONCURRENCY)
+        # Cap the number of concurrent link jobs.
+        vcpkg_list(APPEND arg_OPTIONS "-Dbackend_max_links=${VCPKG_LINK_CONCURRENCY}")
+    endif()
 
     z_vcpkg_get_build_and_host_system(MESON_HOST_MACHINE MESON_BUILD_MACHINE IS_CROSS)
 
@@ -421,10 +446,29 @@ function(vcpkg_configure_meson)
         vcpkg_list(APPEND arg_OPTIONS_DEBUG ${VCPKG_MESON_CONFIGURE_OPTIONS_DEBUG})
     endif()
 
+    set(save_log_files
+        meson-logs/meson-log.txt
+        meson-info/intro-dependencies.json
+        meson-logs/install-log.txt
+    )
+    # The environment variables which are set differently for each configuration.
+    set(config_env_vars PATH PKG_CONFIG PKG_CONFIG_PATH)
+
+    # meson runs its compiler checks one after another, so the configurations are configured concurrently.
+    # Wraps may be extracted into the shared source tree during setup, which must not happen concurrently.
+    set(configure_in_parallel OFF)
+    list(LENGTH buildtypes buildtype_count)
+    file(GLOB wrap_files "${arg_SOURCE_PATH}/subprojects/*.wrap")
+    if(NOT arg_DISABLE_PARALLEL_CONFIGURE AND buildtype_count GREATER "1" AND VCPKG_CONCURRENCY GREATER "1" AND wrap_files STREQUAL "")
+        z_vcpkg_execute_build_process_parallel_supported(configure_in_parallel)
+    endif()
+    set(parallel_configs "")
+
     # configure build
     foreach(buildtype IN LISTS buildtypes)
-        message(STATUS "Configuring ${TARGET_TRIPLET}-${suffix_${buildtype}}")
-        file(MAKE_DIRECTORY "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-${suffix_${buildtype}}")
+        set(short_name "${suffix_${buildtype}}")
+        set(target_dir "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-${short_name}")
+        file(MAKE_DIRECTORY "${target_dir}")
         #setting up PKGCONFIG
         if(NOT arg_NO_PKG_CONFIG)
             z_vcpkg_setup_pkgconfig_path(CONFIG "${buildtype}")
@@ -433,20 +477,60 @@ function(vcpkg_configure_meson)
         z_vcpkg_meson_setup_variables(${buildtype})
         configure_file("${SCRIPTS}/buildsystems/meson/meson.template.in" "${meson_input_file_${buildtype}}" @ONLY)
 
-        vcpkg_execute_required_process(
-            COMMAND ${MESON} ${arg_OPTIONS} ${arg_OPTIONS_${buildtype}} ${arg_SOURCE_PATH}
-            WORKING_DIRECTORY "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-${suffix_${buildtype}}"
-            LOGNAME config-${TARGET_TRIPLET}-${suffix_${buildtype}}
-            SAVE_LOG_FILES
-                meson-logs/meson-log.txt
-                meson-info/intro-dependencies.json
-                meson-logs/install-log.txt
-        )
-
-        message(STATUS "Configuring ${TARGET_TRIPLET}-${suffix_${buildtype}} done")
+        set(command ${MESON} ${arg_OPTIONS} ${arg_OPTIONS_${buildtype}} ${arg_SOURCE_PATH})
+        if(configure_in_parallel)
+            set("${short_name}_command" ${command})
+            set("${short_name}_working_directory" "${target_dir}")
+            set("${short_name}_logname" "config-${TARGET_TRIPLET}-${short_name}")
+            z_vcpkg_snapshot_env_variables("${short_name}_environment" VARS ${config_env_vars})
+            list(APPEND parallel_configs "${short_name}")
+        else()
+            message(STATUS "Configuring ${TARGET_TRIPLET}-${short_name}")
+            vcpkg_execute_required_process(
+                COMMAND ${command}
+                WORKING_DIRECTORY "${target_dir}"
+                LOGNAME config-${TARGET_TRIPLET}-${short_name}
+                SAVE_LOG_FILES ${save_log_files}
+            )
+            message(STATUS "Configuring ${TARGET_TRIPLET}-${short_name} done")
+        endif()
 
         if(NOT arg_NO_PKG_CONFIG)
             z_vcpkg_restore_pkgconfig_path()
         endif()
     endforeach()
+
+    if(configure_in_parallel)
+        list(TRANSFORM parallel_configs PREPEND "${TARGET_TRIPLET}-" OUTPUT_VARIABLE parallel_config_names)
+        list(JOIN parallel_config_names " and " parallel_config_names)
+        message(STATUS "Configuring ${parallel_config_names} in parallel")
+        z_vcpkg_execute_build_process_parallel(
+            PROCESSES ${parallel_configs}
+            WORKING_DIRECTORY "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-parallel-configure"
+            LOGNAME "config-${TARGET_TRIPLET}-parallel"
+            OUT_FAILED_VAR failed_configs
+        )
+        foreach(short_name IN LISTS parallel_configs)
+            set(target_dir "${${short_name}_working_directory}")
+            if(short_name IN_LIST failed_configs)
+                # Configure again on its own to report the failure with the usual logs.
+                message(STATUS "Parallel configure failed for ${TARGET_TRIPLET}-${short_name}; configuring again on its own")
+                file(REMOVE_RECURSE "${target_dir}")
+                file(MAKE_DIRECTORY "${target_dir}")
+                z_vcpkg_snapshot_env_variables(env_before_config VARS ${config_env_vars})
+                cmake_language(EVAL CODE "${${short_name}_environment}")
+                vcpkg_execute_required_process(
+                    COMMAND ${${short_name}_command}
+                    WORKING_DIRECTORY "${target_dir}"
+                    LOGNAME "${${short_name}_logname}"
+                    SAVE_LOG_FILES ${save_log_files}
+                )
+                cmake_language(EVAL CODE "${env_before_config}")
+            else()
+                z_vcpkg_meson_save_log_files("${target_dir}" "${${short_name}_logname}" ${save_log_files})
+            endif()
+        endforeach()
+        message(STATUS "Configuring ${parallel_config_names} done")
+    endif()
+    z_vcpkg_profile_end(vcpkg_configure_meson)
 endfunction()
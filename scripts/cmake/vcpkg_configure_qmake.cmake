@@ -1,4 +1,5 @@
 function(vcpkg_configure_qmake)
+    z_vcpkg_profile_begin(configure vcpkg_configure_qmake)
     # parse parameters such that semicolons in options arguments to COMMAND don't get erased
     cmake_parse_arguments(PARSE_ARGV 0 arg
         ""
@@ -164,4 +165,5 @@ function(vcpkg_configure_qmake)
         z_vcpkg_restore_pkgconfig_path()
     endif()
 
+    z_vcpkg_profile_end(vcpkg_configure_qmake)
 endfunction()
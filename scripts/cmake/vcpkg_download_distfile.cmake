@@ -1,4 +1,124 @@
+# scripts/prefetchDistfiles.py fetches the distfiles of an install plan concurrently with the build.
+# Its download mode pass sets VCPKG_PREFETCH_QUEUE, and the downloads which would be made are
+# appended to that file as JSON lines instead. While a file is being prefetched, "<file>.prefetch"
+# exists and is touched regularly; builds needing the file wait until the marker is removed or stale.
+
+function(z_vcpkg_download_distfile_json_string out_var value)
+    string(REPLACE "\\" "\\\\" value "${value}")
+    string(REPLACE "\"" "\\\"" value "${value}")
+    set("${out_var}" "\"${value}\"" PARENT_SCOPE)
+endfunction()
+
+function(z_vcpkg_download_distfile_queue_prefetch)
+    cmake_parse_arguments(PARSE_ARGV 0 "arg" "" "PATH;SHA512" "URLS;HEADERS")
+    z_vcpkg_download_distfile_json_string(port "${PORT}")
+    z_vcpkg_download_distfile_json_string(path "${arg_PATH}")
+    set(sha512 "null")
+    if(DEFINED arg_SHA512)
+        z_vcpkg_download_distfile_json_string(sha512 "${arg_SHA512}")
+    endif()
+    set(entry "{}")
+    string(JSON entry SET "${entry}" port "${port}")
+    string(JSON entry SET "${entry}" path "${path}")
+    string(JSON entry SET "${entry}" sha512 "${sha512}")
+    foreach(list IN ITEMS URLS HEADERS)
+        set(array "[]")
+        set(index 0)
+        foreach(item IN LISTS arg_${list})
+            z_vcpkg_download_distfile_json_string(item "${item}")
+            string(JSON array SET "${array}" "${index}" "${item}")
+            math(EXPR index "${index} + 1")
+        endforeach()
+        string(TOLOWER "${list}" key)
+        string(JSON entry SET "${entry}" "${key}" "${array}")
+    endforeach()
+    string(REPLACE "\n" "" entry "${entry}")
+    file(APPEND "$ENV{VCPKG_PREFETCH_QUEUE}" "${entry}\n")
+endfunction()
+
+function(z_vcpkg_download_distfile_wait_for_prefetch file_path)
+    set(marker "${file_path}.prefetch")
+    set(waiting OFF)
+    while(EXISTS "${marker}")
+        file(TIMESTAMP "${marker}" touched "%s" UTC)
+        string(TIMESTAMP now "%s" UTC)
+        # The marker of a prefetch which was interrupted is left behind.
+        if("${touched}" STREQUAL "")
+            break()
+        endif()
+        math(EXPR idle "${now} - ${touched}")
+        if(idle GREATER "60")
+            break()
+        endif()
+        if(NOT waiting)
+            cmake_path(GET file_path FILENAME filename)
+            message(STATUS "Waiting for the prefetch of ${filename}")
+            set(waiting ON)
+        endif()
+        vcpkg_execute_in_download_mode(COMMAND "${CMAKE_COMMAND}" -E sleep 1)
+    endwhile()
+endfunction()
+
+# Cached downloads are hashed once. After a successful verification, "<file>.sha512-stamp" records
+# the SHA512 together with the size, modification time and, on Unix, the device and inode of the
+# file. The recorded hash is used for as long as these match. Setting VCPKG_VERIFY_CACHED_DOWNLOADS
+# in the triplet or in the environment (see VCPKG_KEEP_ENV_VARS) hashes cached downloads each time.
+
+function(z_vcpkg_download_distfile_file_identity out_var file_path)
+    file(SIZE "${file_path}" size)
+    file(TIMESTAMP "${file_path}" mtime "%s" UTC)
+    set(identity "size=${size}\nmtime=${mtime}\n")
+    if(CMAKE_HOST_UNIX)
+        if(CMAKE_HOST_APPLE)
+            set(stat_format -f "%d:%i")
+        else()
+            set(stat_format -c "%d:%i")
+        endif()
+        vcpkg_execute_in_download_mode(
+            COMMAND stat ${stat_format} "${file_path}"
+            OUTPUT_VARIABLE inode
+            RESULT_VARIABLE stat_result
+            OUTPUT_STRIP_TRAILING_WHITESPACE
+            ERROR_QUIET
+        )
+        if(stat_result EQUAL "0")
+            string(APPEND identity "inode=${inode}\n")
+        endif()
+    endif()
+    set("${out_var}" "${identity}" PARENT_SCOPE)
+endfunction()
+
+function(z_vcpkg_download_distfile_write_stamp file_path sha512)
+    z_vcpkg_download_distfile_file_identity(identity "${file_path}")
+    # Concurrent builds may verify the same file; the stamp is replaced as a whole.
+    string(RANDOM LENGTH 8 suffix)
+    set(staging "${file_path}.sha512-stamp.${suffix}.tmp")
+    file(WRITE "${staging}" "${identity}sha512=${sha512}\n")
+    file(RENAME "${staging}" "${file_path}.sha512-stamp" RESULT rename_result)
+    if(NOT rename_result STREQUAL "0")
+        file(REMOVE "${staging}")
+    endif()
+endfunction()
+
+# Sets out_var to the SHA512 of file_path, which is taken from its stamp while that is valid.
+function(z_vcpkg_download_distfile_sha512 out_var file_path)
+    set(stamp "${file_path}.sha512-stamp")
+    set(verify_env "$ENV{VCPKG_VERIFY_CACHED_DOWNLOADS}")
+    if(NOT VCPKG_VERIFY_CACHED_DOWNLOADS AND NOT verify_env AND EXISTS "${stamp}")
+        file(READ "${stamp}" stamp_contents)
+        z_vcpkg_download_distfile_file_identity(identity "${file_path}")
+        if(stamp_contents MATCHES "^(.*)sha512=([0-9a-f]+)\n\$" AND CMAKE_MATCH_1 STREQUAL identity)
+            set("${out_var}" "${CMAKE_MATCH_2}" PARENT_SCOPE)
+            return()
+        endif()
+    endif()
+    file(SHA512 "${file_path}" file_hash)
+    z_vcpkg_download_distfile_write_stamp("${file_path}" "${file_hash}")
+    set("${out_var}" "${file_hash}" PARENT_SCOPE)
+endfunction()
+
 function(vcpkg_download_distfile out_var)
+    z_vcpkg_profile_begin(download vcpkg_download_distfile)
     cmake_parse_arguments(PARSE_ARGV 1 arg
         "SKIP_SHA512;SILENT_EXIT;QUIET;ALWAYS_REDOWNLOAD"
         "FILENAME;SHA512"
@@ -54,6 +174,7 @@ If you do not know the SHA512, add it as 'SHA512 0' and retry.")
         file(MAKE_DIRECTORY "${DOWNLOADS}/${directory_component}")
     endif()
 
+    z_vcpkg_download_distfile_wait_for_prefetch("${downloaded_file_path}")
     if(EXISTS "${downloaded_file_path}")
         if(arg_SKIP_SHA512)
             if(NOT arg_ALWAYS_REDOWNLOAD)
@@ -62,14 +183,16 @@ If you do not know the SHA512, add it as 'SHA512 0' and retry.")
                 endif()
 
                 set("${out_var}" "${downloaded_file_path}" PARENT_SCOPE)
+                z_vcpkg_profile_end(vcpkg_download_distfile)
                 return()
             endif()
         else()
             # Note that NOT arg_SKIP_SHA512 implies NOT arg_ALWAYS_REDOWNLOAD
-            file(SHA512 "${downloaded_file_path}" file_hash)
+            z_vcpkg_download_distfile_sha512(file_hash "${downloaded_file_path}")
             if("${file_hash}" STREQUAL "${arg_SHA512}")
                 message(STATUS "Using cached ${arg_FILENAME}")
                 set("${out_var}" "${downloaded_file_path}" PARENT_SCOPE)
+                z_vcpkg_profile_end(vcpkg_download_distfile)
                 return()
             endif()
 
@@ -84,6 +207,7 @@ If you do not know the SHA512, add it as 'SHA512 0' and retry.")
             endif()
 
             set(downloaded_file_path "${DOWNLOADS}/${arg_FILENAME}")
+            z_vcpkg_download_distfile_wait_for_prefetch("${downloaded_file_path}")
             if(EXISTS "${downloaded_file_path}")
                 if(_VCPKG_NO_DOWNLOADS)
                     set(advice_message "note: Downloads are disabled. Please ensure that the expected file is placed at ${downloaded_file_path} and retry.")
@@ -91,10 +215,11 @@ If you do not know the SHA512, add it as 'SHA512 0' and retry.")
                     set(advice_message "note: You may be able to resolve this failure by redownloading the file. To do so, delete ${downloaded_file_path} and retry.")
                 endif()
 
-                file(SHA512 "${downloaded_file_path}" file_hash)
+                z_vcpkg_download_distfile_sha512(file_hash "${downloaded_file_path}")
                 if("${file_hash}" STREQUAL "${arg_SHA512}")
                     message(STATUS "Using cached ${arg_FILENAME}")
                     set("${out_var}" "${downloaded_file_path}" PARENT_SCOPE)
+                    z_vcpkg_profile_end(vcpkg_download_distfile)
                     return()
                 endif()
 
@@ -114,6 +239,20 @@ If you do not know the SHA512, add it as 'SHA512 0' and retry.")
         message(FATAL_ERROR "Downloads are disabled, but '${downloaded_file_path}' does not exist.")
     endif()
 
+    if(VCPKG_DOWNLOAD_MODE AND DEFINED ENV{VCPKG_PREFETCH_QUEUE})
+        set(sha512_param "")
+        if(NOT arg_SKIP_SHA512)
+            set(sha512_param SHA512 "${arg_SHA512}")
+        endif()
+        z_vcpkg_download_distfile_queue_prefetch(PATH "${downloaded_file_path}" ${sha512_param} URLS ${arg_URLS} HEADERS ${arg_HEADERS})
+        message(STATUS "Queued ${arg_FILENAME} for prefetching")
+        # vcpkg_extract_source_archive skips queued archives, so that the portfile reaches its later downloads.
+        set_property(GLOBAL APPEND PROPERTY Z_VCPKG_DOWNLOAD_DISTFILE_QUEUED "${downloaded_file_path}")
+        set("${out_var}" "${downloaded_file_path}" PARENT_SCOPE)
+        z_vcpkg_profile_end(vcpkg_download_distfile)
+        return()
+    endif()
+
     vcpkg_list(SET params "x-download" "${arg_FILENAME}")
     foreach(url IN LISTS arg_URLS)
         vcpkg_list(APPEND params "--url=${url}")
@@ -135,6 +274,11 @@ If you do not know the SHA512, add it as 'SHA512 0' and retry.")
     if(NOT "${error_code}" EQUAL "0")
         message(FATAL_ERROR "Download failed, halting portfile.")
     endif()
+    # vcpkg x-download has verified the hash.
+    if(NOT arg_SKIP_SHA512)
+        z_vcpkg_download_distfile_write_stamp("${downloaded_file_path}" "${arg_SHA512}")
+    endif()
 
     set("${out_var}" "${downloaded_file_path}" PARENT_SCOPE)
+    z_vcpkg_profile_end(vcpkg_download_distfile)
 endfunction()
@@ -1,7 +1,7 @@
 set(Z_VCPKG_EXECUTE_BUILD_PROCESS_RETRY_ERROR_MESSAGES
     "LINK : fatal error LNK1102:"
     " fatal error C1060: "
-    # The linker ran out of memory during execution. We will try continuing once more, with parallelism disabled.
+    # The linker ran out of memory during execution. We will try continuing with less parallelism.
     "LINK : fatal error LNK1318:"
     "LINK : fatal error LNK1104:"
     "LINK : fatal error LNK1201:"
@@ -17,6 +17,39 @@ set(Z_VCPKG_EXECUTE_BUILD_PROCESS_RETRY_ERROR_MESSAGES
 )
 list(JOIN Z_VCPKG_EXECUTE_BUILD_PROCESS_RETRY_ERROR_MESSAGES "|" Z_VCPKG_EXECUTE_BUILD_PROCESS_RETRY_ERROR_MESSAGES)
 
+# Returns the job count given in the command stored in command_var, as `-j<N>` or as
+# `-j`, `-jobs` or `--parallel` followed by `<N>`, or -1 if the command has none.
+function(z_vcpkg_execute_build_process_get_jobs out_var command_var)
+    set(jobs -1)
+    set(previous_arg "")
+    foreach(arg IN LISTS "${command_var}")
+        if(arg MATCHES "^-j([0-9]+)$")
+            set(jobs "${CMAKE_MATCH_1}")
+        elseif(previous_arg MATCHES "^(-j|-jobs|--parallel)$" AND arg MATCHES "^[0-9]+$")
+            set(jobs "${arg}")
+        endif()
+        set(previous_arg "${arg}")
+    endforeach()
+    set("${out_var}" "${jobs}" PARENT_SCOPE)
+endfunction()
+
+# Replaces the job count in the command stored in command_var by jobs.
+function(z_vcpkg_execute_build_process_set_jobs command_var jobs)
+    vcpkg_list(SET new_command)
+    set(previous_arg "")
+    foreach(arg IN LISTS "${command_var}")
+        set(original_arg "${arg}")
+        if(arg MATCHES "^-j([0-9]+)$")
+            set(arg "-j${jobs}")
+        elseif(previous_arg MATCHES "^(-j|-jobs|--parallel)$" AND arg MATCHES "^[0-9]+$")
+            set(arg "${jobs}")
+        endif()
+        vcpkg_list(APPEND new_command "${arg}")
+        set(previous_arg "${original_arg}")
+    endforeach()
+    set("${command_var}" "${new_command}" PARENT_SCOPE)
+endfunction()
+
 function(vcpkg_execute_build_process)
     cmake_parse_arguments(PARSE_ARGV 0 arg "" "WORKING_DIRECTORY;LOGNAME" "COMMAND;NO_PARALLEL_COMMAND")
 
@@ -46,6 +79,7 @@ function(vcpkg_execute_build_process)
         endif()
     endif()
 
+    z_vcpkg_profile_begin(process "${arg_LOGNAME}")
     execute_process(
         COMMAND ${arg_COMMAND}
         WORKING_DIRECTORY "${arg_WORKING_DIRECTORY}"
@@ -63,29 +97,68 @@ function(vcpkg_execute_build_process)
         set(all_contents "${out_contents}${err_contents}")
         if(all_contents MATCHES "${Z_VCPKG_EXECUTE_BUILD_PROCESS_RETRY_ERROR_MESSAGES}")
             message(WARNING "Please ensure your system has sufficient memory.")
-            set(log_out "${log_prefix}-out-1.log")
-            set(log_err "${log_prefix}-err-1.log")
-            list(APPEND all_logs "${log_out}" "${log_err}")
-
-            if(DEFINED arg_NO_PARALLEL_COMMAND)
-                message(STATUS "Restarting build without parallelism")
-                execute_process(
-                    COMMAND ${arg_NO_PARALLEL_COMMAND}
-                    WORKING_DIRECTORY "${arg_WORKING_DIRECTORY}"
-                    OUTPUT_FILE "${log_out}"
-                    ERROR_FILE "${log_err}"
-                    RESULT_VARIABLE error_code
-                )
+            # Step the concurrency down gradually instead of going straight to a serial build:
+            # each restart halves the job count, and the last one uses NO_PARALLEL_COMMAND.
+            z_vcpkg_execute_build_process_get_jobs(jobs arg_COMMAND)
+            set(restarts_log "${log_prefix}-restarts.log")
+            list(APPEND all_logs "${restarts_log}")
+            if(jobs EQUAL "-1")
+                file(WRITE "${restarts_log}" "Build failed with unknown concurrency, exit code ${error_code}\n")
             else()
-                message(STATUS "Restarting build")
+                file(WRITE "${restarts_log}" "Build failed with concurrency ${jobs}, exit code ${error_code}\n")
+            endif()
+
+            set(restart 0)
+            while(1)
+                math(EXPR restart "${restart} + 1")
+                set(log_out "${log_prefix}-out-${restart}.log")
+                set(log_err "${log_prefix}-err-${restart}.log")
+                list(APPEND all_logs "${log_out}" "${log_err}")
+
+                set(last_restart ON)
+                # A single job is left to NO_PARALLEL_COMMAND, so that there is one serial build only.
+                math(EXPR half_jobs "${jobs} / 2")
+                if(half_jobs GREATER "1" OR (half_jobs EQUAL "1" AND NOT DEFINED arg_NO_PARALLEL_COMMAND))
+                    set(jobs "${half_jobs}")
+                    set(command ${arg_COMMAND})
+                    z_vcpkg_execute_build_process_set_jobs(command "${jobs}")
+                    if(jobs GREATER "1" OR DEFINED arg_NO_PARALLEL_COMMAND)
+                        set(last_restart OFF)
+                    endif()
+                    message(STATUS "Restarting build with concurrency ${jobs}")
+                elseif(DEFINED arg_NO_PARALLEL_COMMAND)
+                    set(jobs 1)
+                    set(command ${arg_NO_PARALLEL_COMMAND})
+                    message(STATUS "Restarting build without parallelism")
+                else()
+                    set(command ${arg_COMMAND})
+                    message(STATUS "Restarting build")
+                endif()
                 execute_process(
-                    COMMAND ${arg_COMMAND}
+                    COMMAND ${command}
                     WORKING_DIRECTORY "${arg_WORKING_DIRECTORY}"
                     OUTPUT_FILE "${log_out}"
                     ERROR_FILE "${log_err}"
                     RESULT_VARIABLE error_code
                 )
-            endif()
+                if(jobs EQUAL "-1")
+                    file(APPEND "${restarts_log}" "Restart ${restart} with unknown concurrency, exit code ${error_code}\n")
+                else()
+                    file(APPEND "${restarts_log}" "Restart ${restart} with concurrency ${jobs}, exit code ${error_code}\n")
+                endif()
+                if(error_code EQUAL "0" OR last_restart)
+                    break()
+                endif()
+
+                file(READ "${log_out}" out_contents)
+                file(READ "${log_err}" err_contents)
+                set(all_contents "${out_contents}${err_contents}")
+                if(NOT all_contents MATCHES "${Z_VCPKG_EXECUTE_BUILD_PROCESS_RETRY_ERROR_MESSAGES}")
+                    break()
+                endif()
+            endwhile()
+            file(READ "${restarts_log}" restarts_summary)
+            message(STATUS "Restarted build ${restart} times:\n${restarts_summary}")
         elseif(all_contents MATCHES "mt(\\.exe)? : general error c101008d: ")
             # Antivirus workaround - occasionally files are locked and cause mt.exe to fail
             message(STATUS "mt.exe has failed. This may be the result of anti-virus. Disabling anti-virus on the buildtree folder may improve build speed")
@@ -117,6 +190,8 @@ function(vcpkg_execute_build_process)
         endif()
     endif()
 
+    z_vcpkg_profile_end("${arg_LOGNAME}")
+
     if(NOT error_code EQUAL "0")
         set(stringified_logs "")
         foreach(log IN LISTS all_logs)
@@ -139,3 +214,99 @@ function(vcpkg_execute_build_process)
         )
     endif()
 endfunction()
+
+# Runs several build processes concurrently, one ninja edge per process.
+# For each name in PROCESSES, reads `<name>_command`, `<name>_working_directory`,
+# `<name>_logname` and optionally `<name>_environment` (code from z_vcpkg_snapshot_env_variables)
+# and `<name>_path` (the PATH to use) from the caller's scope.
+# Each process logs to its own `<logname>-out.log` and `<logname>-err.log`.
+# The names of the processes which failed are returned in OUT_FAILED_VAR;
+# callers are expected to rerun them on their own to report the failure.
+function(z_vcpkg_execute_build_process_parallel)
+    cmake_parse_arguments(PARSE_ARGV 0 arg "" "WORKING_DIRECTORY;LOGNAME;OUT_FAILED_VAR" "PROCESSES")
+
+    if(DEFINED arg_UNPARSED_ARGUMENTS)
+        message(FATAL_ERROR "${CMAKE_CURRENT_FUNCTION} was passed extra arguments: ${arg_UNPARSED_ARGUMENTS}")
+    endif()
+    foreach(required_arg IN ITEMS WORKING_DIRECTORY LOGNAME OUT_FAILED_VAR PROCESSES)
+        if(NOT DEFINED arg_${required_arg})
+            message(FATAL_ERROR "${required_arg} must be specified.")
+        endif()
+    endforeach()
+
+    vcpkg_find_acquire_program(NINJA)
+
+    file(REMOVE_RECURSE "${arg_WORKING_DIRECTORY}")
+    file(MAKE_DIRECTORY "${arg_WORKING_DIRECTORY}")
+
+    set(ninja_contents "rule CreateProcess\n  command = \$process\n\n")
+    foreach(name IN LISTS arg_PROCESSES)
+        set(command ${${name}_command})
+        if(X_PORT_PROFILE)
+            vcpkg_list(PREPEND command "${CMAKE_COMMAND}" "-E" "time")
+        endif()
+        set(log_prefix "${CURRENT_BUILDTREES_DIR}/${${name}_logname}")
+
+        set(script_contents "")
+        if(DEFINED "${name}_environment")
+            string(APPEND script_contents "${${name}_environment}")
+        endif()
+        if(DEFINED "${name}_path")
+            string(APPEND script_contents "set(ENV{PATH} [==[${${name}_path}]==])\n")
+        endif()
+        string(APPEND script_contents "execute_process(\n    COMMAND")
+        foreach(arg IN LISTS command)
+            string(APPEND script_contents " [==[${arg}]==]")
+        endforeach()
+        string(APPEND script_contents "
+    WORKING_DIRECTORY [==[${${name}_working_directory}]==]
+    OUTPUT_FILE [==[${log_prefix}-out.log]==]
+    ERROR_FILE [==[${log_prefix}-err.log]==]
+    RESULT_VARIABLE error_code
+)
+file(WRITE [==[${arg_WORKING_DIRECTORY}/${name}.result]==] \"\${error_code}\")
+")
+        file(WRITE "${arg_WORKING_DIRECTORY}/${name}.cmake" "${script_contents}")
+        string(APPEND ninja_contents "build ${name}.result: CreateProcess\n  process = \"${CMAKE_COMMAND}\" -P \"${name}.cmake\"\n\n")
+    endforeach()
+    file(WRITE "${arg_WORKING_DIRECTORY}/build.ninja" "${ninja_contents}")
+
+    vcpkg_execute_required_process(
+        COMMAND "${NINJA}" -v -k 0
+        WORKING_DIRECTORY "${arg_WORKING_DIRECTORY}"
+        LOGNAME "${arg_LOGNAME}"
+    )
+
+    set(failed "")
+    foreach(name IN LISTS arg_PROCESSES)
+        set(error_code "")
+        if(EXISTS "${arg_WORKING_DIRECTORY}/${name}.result")
+            file(READ "${arg_WORKING_DIRECTORY}/${name}.result" error_code)
+        endif()
+        if(NOT error_code STREQUAL "0")
+            list(APPEND failed "${name}")
+        endif()
+    endforeach()
+    set("${arg_OUT_FAILED_VAR}" "${failed}" PARENT_SCOPE)
+endfunction()
+
+# Sets out_var to whether z_vcpkg_execute_build_process_parallel can run on this host.
+# Prebuilt ninja binaries are only provided for x64 hosts, so other hosts need a ninja on PATH.
+function(z_vcpkg_execute_build_process_parallel_supported out_var)
+    set(host_architecture "")
+    if(CMAKE_HOST_WIN32)
+        if(DEFINED ENV{PROCESSOR_ARCHITEW6432})
+            set(host_architecture "$ENV{PROCESSOR_ARCHITEW6432}")
+        else()
+            set(host_architecture "$ENV{PROCESSOR_ARCHITECTURE}")
+        endif()
+    endif()
+    set(supported ON)
+    if(host_architecture STREQUAL "x86" OR DEFINED ENV{VCPKG_FORCE_SYSTEM_BINARIES})
+        find_program(NINJA NAMES ninja ninja-build)
+        if(NOT NINJA)
+            set(supported OFF)
+        endif()
+    endif()
+    set("${out_var}" "${supported}" PARENT_SCOPE)
+endfunction()
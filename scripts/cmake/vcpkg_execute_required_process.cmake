@@ -60,6 +60,7 @@ Halting portfile execution.
         vcpkg_list(PREPEND arg_COMMAND "${CMAKE_COMMAND}" "-E" "time")
     endif()
 
+    z_vcpkg_profile_begin(process "${arg_LOGNAME}")
     vcpkg_execute_in_download_mode(
         COMMAND ${arg_COMMAND}
         RESULT_VARIABLE error_code
@@ -68,6 +69,7 @@ Halting portfile execution.
         ${output_param}
         ${error_param}
     )
+    z_vcpkg_profile_end("${arg_LOGNAME}")
 
     if(output_and_error_same)
         file(WRITE "${log_out}" "${out_err_var}")
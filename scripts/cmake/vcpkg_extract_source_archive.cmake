@@ -1,5 +1,10 @@
 function(z_vcpkg_extract_source_archive_deprecated_mode archive working_directory)
     cmake_path(GET archive FILENAME archive_filename)
+    get_property(queued_archives GLOBAL PROPERTY Z_VCPKG_DOWNLOAD_DISTFILE_QUEUED)
+    if(archive IN_LIST queued_archives)
+        message(STATUS "Skipping the extraction of queued ${archive}")
+        return()
+    endif()
     if(NOT EXISTS "${working_directory}/${archive_filename}.extracted")
         message(STATUS "Extracting source ${archive}")
         vcpkg_extract_archive(ARCHIVE "${archive}" DESTINATION "${working_directory}")
@@ -7,7 +12,48 @@ function(z_vcpkg_extract_source_archive_deprecated_mode archive working_director
     endif()
 endfunction()
 
+# Copies the source tree FROM to the new directory TO.
+# Hardlinks are not used because portfiles edit the sources in place, e.g. through vcpkg_replace_string;
+# reflinks (copy-on-write clones) are used instead where the host and the filesystem support them.
+function(z_vcpkg_extract_source_archive_copy_tree from to)
+    file(REMOVE_RECURSE "${to}")
+    if(VCPKG_HOST_IS_LINUX)
+        set(copy_command cp -a --reflink=auto "${from}" "${to}")
+    elseif(VCPKG_HOST_IS_OSX)
+        set(copy_command cp -c -R -p "${from}" "${to}")
+    else()
+        set(copy_command "")
+    endif()
+    if(NOT copy_command STREQUAL "")
+        execute_process(
+            COMMAND ${copy_command}
+            RESULT_VARIABLE copy_result
+            OUTPUT_QUIET ERROR_QUIET
+        )
+        if(copy_result STREQUAL "0")
+            return()
+        endif()
+        file(REMOVE_RECURSE "${to}")
+    endif()
+    file(MAKE_DIRECTORY "${to}")
+    file(COPY "${from}/" DESTINATION "${to}")
+endfunction()
+
+# Publishes the patched source tree SOURCE_PATH as the cache entry ENTRY.
+# Concurrent builds may publish the same entry; the copy is staged privately and renamed into place,
+# which fails without harm when another build published the entry first.
+function(z_vcpkg_extract_source_archive_cache_store source_path entry)
+    string(RANDOM LENGTH 8 suffix)
+    set(staging "${entry}.${suffix}.tmp")
+    cmake_path(GET entry PARENT_PATH cache_dir)
+    file(MAKE_DIRECTORY "${cache_dir}")
+    z_vcpkg_extract_source_archive_copy_tree("${source_path}" "${staging}")
+    file(RENAME "${staging}" "${entry}" RESULT rename_result)
+    file(REMOVE_RECURSE "${staging}")
+endfunction()
+
 function(vcpkg_extract_source_archive)
+    z_vcpkg_profile_begin(extract vcpkg_extract_source_archive)
     if(ARGC LESS_EQUAL "2")
         z_vcpkg_deprecation_message( "Deprecated form of vcpkg_extract_source_archive used:
     Please use the `vcpkg_extract_source_archive(<out-var> ARCHIVE <archive>)` form.")
@@ -23,6 +69,7 @@ function(vcpkg_extract_source_archive)
         endif()
 
         z_vcpkg_extract_source_archive_deprecated_mode("${archive}" "${working_directory}")
+        z_vcpkg_profile_end(vcpkg_extract_source_archive)
         return()
     endif()
 
@@ -81,6 +128,19 @@ function(vcpkg_extract_source_archive)
         string(SUBSTRING "${arg_SOURCE_BASE}" "${start}" -1 arg_SOURCE_BASE)
     endif()
 
+    # In the download mode pass of prefetchDistfiles.py, the archive was only queued by vcpkg_download_distfile.
+    # An empty source directory lets the portfile go on to its later downloads.
+    get_property(queued_archives GLOBAL PROPERTY Z_VCPKG_DOWNLOAD_DISTFILE_QUEUED)
+    if(arg_ARCHIVE IN_LIST queued_archives)
+        cmake_path(APPEND working_directory "${arg_SOURCE_BASE}.queued" OUTPUT_VARIABLE source_path)
+        file(REMOVE_RECURSE "${source_path}")
+        file(MAKE_DIRECTORY "${source_path}")
+        message(STATUS "Skipping the extraction of queued ${arg_ARCHIVE}")
+        set("${out_source_path}" "${source_path}" PARENT_SCOPE)
+        z_vcpkg_profile_end(vcpkg_extract_source_archive)
+        return()
+    endif()
+
     # Hash the archive hash along with the patches. Take the first 10 chars of the hash
     file(SHA512 "${arg_ARCHIVE}" patchset_hash)
     foreach(patch IN LISTS arg_PATCHES)
@@ -96,6 +156,9 @@ function(vcpkg_extract_source_archive)
     endforeach()
 
     string(SHA512 patchset_hash "${patchset_hash}")
+    # The patched tree also depends on how the archive is unwrapped and whether patches may fail.
+    string(SHA512 cache_key "${patchset_hash};${arg_NO_REMOVE_ONE_LEVEL};${arg_SKIP_PATCH_CHECK}")
+    string(SUBSTRING "${cache_key}" 0 32 cache_key)
     string(SUBSTRING "${patchset_hash}" 0 10 patchset_hash)
     cmake_path(APPEND working_directory "${arg_SOURCE_BASE}-${patchset_hash}"
         OUTPUT_VARIABLE source_path
@@ -104,6 +167,7 @@ function(vcpkg_extract_source_archive)
     if(_VCPKG_EDITABLE AND EXISTS "${source_path}")
         set("${out_source_path}" "${source_path}" PARENT_SCOPE)
         message(STATUS "Using source at ${source_path}")
+        z_vcpkg_profile_end(vcpkg_extract_source_archive)
         return()
     elseif(NOT _VCPKG_EDITABLE)
         cmake_path(APPEND_STRING source_path ".clean")
@@ -113,6 +177,20 @@ function(vcpkg_extract_source_archive)
         endif()
     endif()
 
+    # Editable trees are modified by the user, so only clean trees are shared between builds.
+    set(cache_entry "")
+    if(NOT _VCPKG_EDITABLE AND NOT "${VCPKG_SOURCE_TREE_CACHE_DIR}" STREQUAL "")
+        cmake_path(APPEND VCPKG_SOURCE_TREE_CACHE_DIR "${cache_key}" OUTPUT_VARIABLE cache_entry)
+        if(IS_DIRECTORY "${cache_entry}")
+            message(STATUS "Copying cached source tree ${cache_entry}")
+            z_vcpkg_extract_source_archive_copy_tree("${cache_entry}" "${source_path}")
+            set("${out_source_path}" "${source_path}" PARENT_SCOPE)
+            message(STATUS "Using source at ${source_path}")
+            z_vcpkg_profile_end(vcpkg_extract_source_archive)
+            return()
+        endif()
+    endif()
+
     message(STATUS "Extracting source ${arg_ARCHIVE}")
     cmake_path(APPEND_STRING source_path ".tmp" OUTPUT_VARIABLE temp_dir)
     file(REMOVE_RECURSE "${temp_dir}")
@@ -150,9 +228,14 @@ function(vcpkg_extract_source_archive)
         ${quiet_param}
     )
 
+    if(NOT cache_entry STREQUAL "")
+        z_vcpkg_extract_source_archive_cache_store("${temp_source_path}" "${cache_entry}")
+    endif()
+
     file(RENAME "${temp_source_path}" "${source_path}")
     file(REMOVE_RECURSE "${temp_dir}")
 
     set("${out_source_path}" "${source_path}" PARENT_SCOPE)
     message(STATUS "Using source at ${source_path}")
+    z_vcpkg_profile_end(vcpkg_extract_source_archive)
 endfunction()
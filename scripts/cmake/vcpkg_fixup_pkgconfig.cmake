@@ -142,7 +142,66 @@ function(z_vcpkg_fixup_pkgconfig_check_files arg_file arg_config)
     z_vcpkg_restore_pkgconfig_path()
 endfunction()
 
+# Checks all files of a config with a single pkg-config invocation per batch of packages.
+# When a batch fails, the packages of this batch are checked one by one for the detailed error.
+function(z_vcpkg_fixup_pkgconfig_check_config arg_config)
+    set(batch_size 100)
+    set(package_names "")
+    foreach(file IN LISTS ARGN)
+        cmake_path(GET file STEM LAST_ONLY package_name)
+        list(APPEND package_names "${package_name}")
+    endforeach()
+    list(REMOVE_DUPLICATES package_names)
+    list(LENGTH package_names package_count)
+    if(package_count EQUAL "0")
+        return()
+    endif()
+
+    z_vcpkg_setup_pkgconfig_path(CONFIG "${arg_config}")
+    set(failed_files "")
+    set(batch "")
+    set(batch_count 0)
+    set(index 0)
+    foreach(package_name IN LISTS package_names)
+        list(APPEND batch "${package_name}")
+        math(EXPR batch_count "${batch_count} + 1")
+        math(EXPR index "${index} + 1")
+        if(batch_count LESS batch_size AND index LESS package_count)
+            continue()
+        endif()
+        list(JOIN batch " " batch_string)
+        debug_message("Checking packages (${arg_config}): ${batch_string}")
+        execute_process(
+            COMMAND "${PKGCONFIG}" --print-errors --exists ${batch}
+            WORKING_DIRECTORY "${CURRENT_BUILDTREES_DIR}"
+            RESULT_VARIABLE error_var
+            OUTPUT_VARIABLE output
+            ERROR_VARIABLE  output
+            OUTPUT_STRIP_TRAILING_WHITESPACE
+            ERROR_STRIP_TRAILING_WHITESPACE
+        )
+        if("${error_var}" EQUAL "0")
+            debug_message("pkg-config --exists ${batch_string} output: ${output}")
+        else()
+            foreach(file IN LISTS ARGN)
+                cmake_path(GET file STEM LAST_ONLY package_name)
+                if(package_name IN_LIST batch)
+                    list(APPEND failed_files "${file}")
+                endif()
+            endforeach()
+        endif()
+        set(batch "")
+        set(batch_count 0)
+    endforeach()
+    z_vcpkg_restore_pkgconfig_path()
+
+    foreach(file IN LISTS failed_files)
+        z_vcpkg_fixup_pkgconfig_check_files("${file}" "${arg_config}")
+    endforeach()
+endfunction()
+
 function(vcpkg_fixup_pkgconfig)
+    z_vcpkg_profile_begin(fixup vcpkg_fixup_pkgconfig)
     cmake_parse_arguments(PARSE_ARGV 0 arg 
         "SKIP_CHECK"
         ""
@@ -192,9 +251,7 @@ function(vcpkg_fixup_pkgconfig)
         if(NOT arg_SKIP_CHECK) # The check can only run after all files have been corrected!
             vcpkg_find_acquire_program(PKGCONFIG)
             debug_message("Using pkg-config from: ${PKGCONFIG}")
-            foreach(file IN LISTS "arg_${config}_FILES")
-                z_vcpkg_fixup_pkgconfig_check_files("${file}" "${config}")
-            endforeach()
+            z_vcpkg_fixup_pkgconfig_check_config("${config}" ${arg_${config}_FILES})
         endif()
     endforeach()
     debug_message("Fixing pkgconfig --- finished")
@@ -204,4 +261,5 @@ function(vcpkg_fixup_pkgconfig)
     # Theoreotically vcpkg could look for *.pc files and automatically call this function
     # or check if this function has been called if *.pc files are detected.
     # The same is true for vcpkg_fixup_cmake_targets
+    z_vcpkg_profile_end(vcpkg_fixup_pkgconfig)
 endfunction()
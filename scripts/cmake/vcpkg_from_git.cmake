@@ -1,4 +1,111 @@
+# Checks out the commit REV from the git directory GIT_DIR and applies PATCHES,
+# like vcpkg_extract_source_archive does for an archive of that commit.
+function(z_vcpkg_from_git_checkout out_source_path)
+    cmake_parse_arguments(PARSE_ARGV 1 "arg" "" "GIT_DIR;REV;SOURCE_BASE" "PATCHES")
+
+    # Take the last 10 chars of the base
+    string(LENGTH "${arg_SOURCE_BASE}" source_base_length)
+    if(source_base_length GREATER "10")
+        math(EXPR start "${source_base_length} - 10")
+        string(SUBSTRING "${arg_SOURCE_BASE}" "${start}" -1 arg_SOURCE_BASE)
+    endif()
+
+    # Hash the commit along with the patches. Take the first 10 chars of the hash
+    set(patchset_hash "${arg_REV}")
+    foreach(patch IN LISTS arg_PATCHES)
+        cmake_path(ABSOLUTE_PATH patch
+            BASE_DIRECTORY "${CURRENT_PORT_DIR}"
+            OUTPUT_VARIABLE absolute_patch
+        )
+        if(NOT EXISTS "${absolute_patch}")
+            message(FATAL_ERROR "Could not find patch: '${patch}'")
+        endif()
+        file(SHA512 "${absolute_patch}" current_hash)
+        string(APPEND patchset_hash "${current_hash}")
+    endforeach()
+    string(SHA512 patchset_hash "${patchset_hash}")
+    string(SUBSTRING "${patchset_hash}" 0 10 patchset_hash)
+    set(source_path "${CURRENT_BUILDTREES_DIR}/src/${arg_SOURCE_BASE}-${patchset_hash}")
+
+    if(_VCPKG_EDITABLE AND EXISTS "${source_path}")
+        set("${out_source_path}" "${source_path}" PARENT_SCOPE)
+        message(STATUS "Using source at ${source_path}")
+        return()
+    elseif(NOT _VCPKG_EDITABLE)
+        string(APPEND source_path ".clean")
+        if(EXISTS "${source_path}")
+            message(STATUS "Cleaning sources at ${source_path}. Use --editable to skip cleaning for the packages you specify.")
+            file(REMOVE_RECURSE "${source_path}")
+        endif()
+    endif()
+
+    message(STATUS "Checking out ${arg_REV}")
+    set(temp_dir "${source_path}.tmp")
+    file(REMOVE_RECURSE "${temp_dir}")
+    file(MAKE_DIRECTORY "${temp_dir}")
+    # checkout-index ignores the export-ignore and export-subst attributes, which git archive applies.
+    # Trees using them are exported with git archive, so that the sources match the archive path.
+    vcpkg_execute_in_download_mode(
+        COMMAND "${GIT}" "--git-dir=${arg_GIT_DIR}" grep --quiet -E "export-(ignore|subst)" "${arg_REV}" -- ":(glob)**/.gitattributes"
+        RESULT_VARIABLE export_attributes_result
+        OUTPUT_QUIET
+        ERROR_QUIET
+        WORKING_DIRECTORY "${temp_dir}"
+    )
+    if(export_attributes_result STREQUAL "0")
+        vcpkg_execute_required_process(
+            ALLOW_IN_DOWNLOAD_MODE
+            COMMAND "${GIT}" -c core.autocrlf=false "--git-dir=${arg_GIT_DIR}" archive --format=tar "${arg_REV}" -o "${temp_dir}.tar"
+            WORKING_DIRECTORY "${temp_dir}"
+            LOGNAME "git-archive-${TARGET_TRIPLET}"
+        )
+        vcpkg_execute_required_process(
+            ALLOW_IN_DOWNLOAD_MODE
+            COMMAND "${CMAKE_COMMAND}" -E tar xf "${temp_dir}.tar"
+            WORKING_DIRECTORY "${temp_dir}"
+            LOGNAME "extract-${TARGET_TRIPLET}"
+        )
+        file(REMOVE "${temp_dir}.tar")
+    else()
+        # A private index keeps concurrent checkouts from the shared git directory apart.
+        if(DEFINED ENV{GIT_INDEX_FILE})
+            set(git_index_file_backup "$ENV{GIT_INDEX_FILE}")
+        else()
+            unset(git_index_file_backup)
+        endif()
+        set(ENV{GIT_INDEX_FILE} "${temp_dir}.index")
+        vcpkg_execute_required_process(
+            ALLOW_IN_DOWNLOAD_MODE
+            COMMAND "${GIT}" "--git-dir=${arg_GIT_DIR}" read-tree "${arg_REV}"
+            WORKING_DIRECTORY "${temp_dir}"
+            LOGNAME "git-read-tree-${TARGET_TRIPLET}"
+        )
+        vcpkg_execute_required_process(
+            ALLOW_IN_DOWNLOAD_MODE
+            COMMAND "${GIT}" -c core.longpaths=true -c core.autocrlf=false "--git-dir=${arg_GIT_DIR}" --work-tree=. checkout-index --all --force
+            WORKING_DIRECTORY "${temp_dir}"
+            LOGNAME "git-checkout-index-${TARGET_TRIPLET}"
+        )
+        if(DEFINED git_index_file_backup)
+            set(ENV{GIT_INDEX_FILE} "${git_index_file_backup}")
+        else()
+            unset(ENV{GIT_INDEX_FILE})
+        endif()
+        file(REMOVE "${temp_dir}.index")
+    endif()
+
+    z_vcpkg_apply_patches(
+        SOURCE_PATH "${temp_dir}"
+        PATCHES ${arg_PATCHES}
+    )
+
+    file(RENAME "${temp_dir}" "${source_path}")
+    set("${out_source_path}" "${source_path}" PARENT_SCOPE)
+    message(STATUS "Using source at ${source_path}")
+endfunction()
+
 function(vcpkg_from_git)
+    z_vcpkg_profile_begin(download vcpkg_from_git)
     cmake_parse_arguments(PARSE_ARGV 0 "arg"
         ""
         "OUT_SOURCE_PATH;URL;REF;FETCH_REF;HEAD_REF;TAG;LFS"
@@ -65,6 +172,41 @@ function(vcpkg_from_git)
     set(temp_archive "${DOWNLOADS}/temp/${PORT}-${sanitized_ref}.tar.gz")
     set(archive "${DOWNLOADS}/${PORT}-${sanitized_ref}.tar.gz")
 
+    # With VCPKG_FROM_GIT_DIRECT_CHECKOUT, REF is checked out from a bare repository shared by all
+    # ports using URL, instead of going through an archive. An existing archive is still used,
+    # and HEAD and LFS sources always go through an archive.
+    set(direct_checkout OFF)
+    vcpkg_list(SET git_init_param)
+    if(VCPKG_FROM_GIT_DIRECT_CHECKOUT AND NOT VCPKG_USE_HEAD_VERSION AND NOT arg_LFS AND NOT EXISTS "${archive}")
+        find_program(GIT NAMES git git.cmd)
+        string(SHA256 url_hash "${arg_URL}")
+        string(SUBSTRING "${url_hash}" 0 16 url_hash)
+        set(git_working_directory "${DOWNLOADS}/git-objects/${url_hash}")
+        vcpkg_list(SET git_init_param --bare)
+        set(direct_checkout ON)
+        if(EXISTS "${git_working_directory}/HEAD")
+            vcpkg_execute_in_download_mode(
+                COMMAND "${GIT}" cat-file -e "${arg_REF}^{commit}"
+                RESULT_VARIABLE error_code
+                OUTPUT_QUIET
+                ERROR_QUIET
+                WORKING_DIRECTORY "${git_working_directory}"
+            )
+            if(NOT error_code)
+                message(STATUS "Using cached ${arg_URL} ${arg_REF}")
+                z_vcpkg_from_git_checkout(SOURCE_PATH
+                    GIT_DIR "${git_working_directory}"
+                    REV "${arg_REF}"
+                    SOURCE_BASE "${sanitized_ref}"
+                    PATCHES ${arg_PATCHES}
+                )
+                set("${arg_OUT_SOURCE_PATH}" "${SOURCE_PATH}" PARENT_SCOPE)
+                z_vcpkg_profile_end(vcpkg_from_git)
+                return()
+            endif()
+        endif()
+    endif()
+
     if(NOT EXISTS "${archive}")
         if(_VCPKG_NO_DOWNLOADS)
             message(FATAL_ERROR "Downloads are disabled, but '${archive}' does not exist.")
@@ -79,7 +221,7 @@ function(vcpkg_from_git)
         # Note: git init is safe to run multiple times
         vcpkg_execute_required_process(
             ALLOW_IN_DOWNLOAD_MODE
-            COMMAND "${GIT}" init "${git_working_directory}"
+            COMMAND "${GIT}" init ${git_init_param} "${git_working_directory}"
             WORKING_DIRECTORY "${CURRENT_BUILDTREES_DIR}"
             LOGNAME "git-init-${TARGET_TRIPLET}"
         )
@@ -163,6 +305,26 @@ SHA is in the history. For example, you may be able to fix this error by changin
             )
         endif()
 
+        if(direct_checkout)
+            # The fetched commit is only reachable from FETCH_HEAD, which the next fetch replaces;
+            # a ref keeps it from being pruned by git gc.
+            vcpkg_execute_required_process(
+                ALLOW_IN_DOWNLOAD_MODE
+                COMMAND "${GIT}" update-ref "refs/vcpkg/${rev_parse_ref}" "${rev_parse_ref}"
+                WORKING_DIRECTORY "${git_working_directory}"
+                LOGNAME "git-update-ref-${TARGET_TRIPLET}"
+            )
+            z_vcpkg_from_git_checkout(SOURCE_PATH
+                GIT_DIR "${git_working_directory}"
+                REV "${rev_parse_ref}"
+                SOURCE_BASE "${sanitized_ref}"
+                PATCHES ${arg_PATCHES}
+            )
+            set("${arg_OUT_SOURCE_PATH}" "${SOURCE_PATH}" PARENT_SCOPE)
+            z_vcpkg_profile_end(vcpkg_from_git)
+            return()
+        endif()
+
         file(MAKE_DIRECTORY "${DOWNLOADS}/temp")
         vcpkg_execute_required_process(
             ALLOW_IN_DOWNLOAD_MODE
@@ -186,4 +348,5 @@ SHA is in the history. For example, you may be able to fix this error by changin
     )
 
     set("${arg_OUT_SOURCE_PATH}" "${SOURCE_PATH}" PARENT_SCOPE)
+    z_vcpkg_profile_end(vcpkg_from_git)
 endfunction()
@@ -1,4 +1,5 @@
 function(vcpkg_install_cmake)
+    z_vcpkg_profile_begin(install vcpkg_install_cmake)
     if(Z_VCPKG_CMAKE_INSTALL_GUARD)
         message(FATAL_ERROR "The ${PORT} port already depends on vcpkg-cmake; using both vcpkg-cmake and vcpkg_install_cmake in the same port is unsupported.")
     endif()
@@ -20,4 +21,5 @@ function(vcpkg_install_cmake)
         LOGFILE_ROOT install
         TARGET install
     )
+    z_vcpkg_profile_end(vcpkg_install_cmake)
 endfunction()
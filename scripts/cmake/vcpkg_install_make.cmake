@@ -1,6 +1,8 @@
 function(vcpkg_install_make)
+    z_vcpkg_profile_begin(install vcpkg_install_make)
     vcpkg_build_make(
         ${ARGN}
         ENABLE_INSTALL
     )
+    z_vcpkg_profile_end(vcpkg_install_make)
 endfunction()
@@ -1,4 +1,5 @@
 function(vcpkg_install_meson)
+    z_vcpkg_profile_begin(install vcpkg_install_meson)
     cmake_parse_arguments(PARSE_ARGV 0 arg "ADD_BIN_TO_PATH" "" "")
 
     vcpkg_find_acquire_program(NINJA)
@@ -68,4 +69,5 @@ function(vcpkg_install_meson)
     if(VCPKG_TARGET_IS_OSX)
         vcpkg_restore_env_variables(VARS SDKROOT MACOSX_DEPLOYMENT_TARGET)
     endif()
+    z_vcpkg_profile_end(vcpkg_install_meson)
 endfunction()
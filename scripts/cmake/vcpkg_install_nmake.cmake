@@ -1,4 +1,5 @@
 function(vcpkg_install_nmake)
+    z_vcpkg_profile_begin(install vcpkg_install_nmake)
     vcpkg_list(SET multi_value_args
         TARGET
         OPTIONS OPTIONS_DEBUG OPTIONS_RELEASE
@@ -54,4 +55,5 @@ function(vcpkg_install_nmake)
         ENABLE_INSTALL
         LOGFILE_ROOT install
         ${extra_args})
+    z_vcpkg_profile_end(vcpkg_install_nmake)
 endfunction()
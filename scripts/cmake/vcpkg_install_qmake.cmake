@@ -1,4 +1,5 @@
 function(vcpkg_install_qmake)
+    z_vcpkg_profile_begin(install vcpkg_install_qmake)
     z_vcpkg_function_arguments(args)
 
     vcpkg_build_qmake(${args})
@@ -42,4 +43,5 @@ function(vcpkg_install_qmake)
         file(MAKE_DIRECTORY "${CURRENT_PACKAGES_DIR}/debug/bin")
         file(COPY ${debug_bins} DESTINATION "${CURRENT_PACKAGES_DIR}/debug/bin")
     endif()
+    z_vcpkg_profile_end(vcpkg_install_qmake)
 endfunction()
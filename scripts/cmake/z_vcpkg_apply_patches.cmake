@@ -1,4 +1,5 @@
 function(z_vcpkg_apply_patches)
+    z_vcpkg_profile_begin(patch z_vcpkg_apply_patches)
     cmake_parse_arguments(PARSE_ARGV 0 "arg" "QUIET" "SOURCE_PATH" "PATCHES")
 
     if(DEFINED arg_UNPARSED_ARGUMENTS)
@@ -42,4 +43,5 @@ function(z_vcpkg_apply_patches)
     else()
         unset(ENV{GIT_CONFIG_NOSYSTEM})
     endif()
+    z_vcpkg_profile_end(z_vcpkg_apply_patches)
 endfunction()
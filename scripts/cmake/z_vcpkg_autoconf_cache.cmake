@@ -0,0 +1,211 @@
+# Persistent cache for the results of autoconf configure scripts, shared by the ports of a triplet.
+# It is enabled by setting VCPKG_AUTOCONF_CACHE_DIR, e.g. in the triplet file.
+# Ports whose configure results must not be shared can be listed in VCPKG_AUTOCONF_CACHE_DENYLIST.
+#
+# Only results which depend on the toolchain alone are shared. Checks for headers, libraries and
+# functions depend on the dependencies of a port, and type sizes on its defines such as
+# _FILE_OFFSET_BITS, so they are never taken from the cache.
+
+# Ports whose configure scripts pick their own ABI or compiler flags.
+set(Z_VCPKG_AUTOCONF_CACHE_DEFAULT_DENYLIST gmp nettle)
+
+# Cache variables which are shared between ports.
+set(Z_VCPKG_AUTOCONF_CACHE_SHARED_VARIABLES
+    "^ac_cv_(build|host|target)$"
+    "^ac_cv_(objext|exeext)$"
+    "^ac_cv_(c|cxx|objc|objcxx|fc|f77)_compiler_gnu$"
+    "^ac_cv_prog_(cc|cxx|objc|objcxx|fc|f77)_"
+    "^ac_cv_prog_(AWK|CPP|CXXCPP|make_make_set)$"
+    "^ac_cv_path_(SED|GREP|EGREP|FGREP|install|mkdir)$"
+    "^ac_cv_c_(bigendian|char_unsigned|const|inline|restrict|volatile)$"
+    "^ac_cv_sys_(file_offset_bits|large_files|largefile_)"
+    "^am_cv_(CC|CXX|OBJC|OBJCXX)_dependencies_compiler_type$"
+    "^am_cv_prog_"
+    "^lt_cv_"
+)
+
+# Computes the cache key for configuring CONFIG with CONFIGURE_ENV and OPTIONS in the current
+# environment. Sets out_var to an empty string when the cache is disabled for the port or for
+# CONFIGURE_SCRIPT.
+function(z_vcpkg_autoconf_cache_key out_var)
+    cmake_parse_arguments(PARSE_ARGV 1 "arg" "" "CONFIG;CONFIGURE_SCRIPT;CONFIGURE_ENV" "OPTIONS")
+
+    if(DEFINED arg_UNPARSED_ARGUMENTS)
+        message(FATAL_ERROR "${CMAKE_CURRENT_FUNCTION} was passed extra arguments: ${arg_UNPARSED_ARGUMENTS}")
+    endif()
+    foreach(required IN ITEMS CONFIG CONFIGURE_SCRIPT)
+        if(NOT DEFINED arg_${required})
+            message(FATAL_ERROR "${required} must be specified.")
+        endif()
+    endforeach()
+
+    set("${out_var}" "" PARENT_SCOPE)
+    if("${VCPKG_AUTOCONF_CACHE_DIR}" STREQUAL "")
+        return()
+    endif()
+    if("${PORT}" IN_LIST VCPKG_AUTOCONF_CACHE_DENYLIST OR "${PORT}" IN_LIST Z_VCPKG_AUTOCONF_CACHE_DEFAULT_DENYLIST)
+        debug_message("The autoconf cache is disabled for ${PORT}")
+        return()
+    endif()
+    # Ports managing their own cache file keep it.
+    if(arg_OPTIONS MATCHES "(^|[; ])\"?(--cache-file=|-C\"?([; ]|$)|--config-cache)")
+        return()
+    endif()
+    # Configure scripts which are not generated by autoconf do not accept --cache-file.
+    if(NOT EXISTS "${arg_CONFIGURE_SCRIPT}")
+        return()
+    endif()
+    file(STRINGS "${arg_CONFIGURE_SCRIPT}" generator LIMIT_COUNT 20 REGEX "Generated by GNU Autoconf")
+    if(generator STREQUAL "")
+        return()
+    endif()
+
+    set(key_material "config=${arg_CONFIG}\nconfigure-env=${arg_CONFIGURE_ENV}\n")
+    # Options selecting the build and host systems change the detected toolchain.
+    foreach(option IN LISTS arg_OPTIONS)
+        if(option MATCHES "--(build|host|target)=")
+            string(APPEND key_material "option=${option}\n")
+        endif()
+    endforeach()
+    foreach(var IN ITEMS
+        TARGET_TRIPLET
+        VCPKG_TARGET_ARCHITECTURE
+        VCPKG_TARGET_ISA_LEVEL
+        VCPKG_ENABLE_LTO
+        VCPKG_CMAKE_SYSTEM_NAME
+        VCPKG_CMAKE_SYSTEM_VERSION
+        VCPKG_PLATFORM_TOOLSET
+        VCPKG_LIBRARY_LINKAGE
+        VCPKG_CRT_LINKAGE
+        VCPKG_CHAINLOAD_TOOLCHAIN_FILE
+        VCPKG_C_FLAGS VCPKG_C_FLAGS_DEBUG VCPKG_C_FLAGS_RELEASE
+        VCPKG_CXX_FLAGS VCPKG_CXX_FLAGS_DEBUG VCPKG_CXX_FLAGS_RELEASE
+        VCPKG_LINKER_FLAGS VCPKG_LINKER_FLAGS_DEBUG VCPKG_LINKER_FLAGS_RELEASE
+        VCPKG_OSX_DEPLOYMENT_TARGET
+        VCPKG_OSX_SYSROOT
+        VCPKG_OSX_ARCHITECTURES
+        VCPKG_MAKE_CONFIGURE_OPTIONS VCPKG_MAKE_CONFIGURE_OPTIONS_DEBUG VCPKG_MAKE_CONFIGURE_OPTIONS_RELEASE
+        _VCPKG_INSTALLED_DIR
+    )
+        string(APPEND key_material "${var}=${${var}}\n")
+    endforeach()
+
+    foreach(env_var IN ITEMS
+        CC CXX CPP AR AS LD NM RANLIB STRIP
+        CPPFLAGS CFLAGS CXXFLAGS LDFLAGS LIBS ARFLAGS
+        _CL_ _LINK_ INCLUDE LIB
+        SDKROOT MACOSX_DEPLOYMENT_TARGET
+    )
+        string(APPEND key_material "ENV{${env_var}}=$ENV{${env_var}}\n")
+    endforeach()
+
+    # Updated compilers invalidate the entries.
+    foreach(var IN ITEMS
+        VCPKG_DETECTED_CMAKE_C_COMPILER
+        VCPKG_DETECTED_CMAKE_CXX_COMPILER
+        VCPKG_DETECTED_CMAKE_AR
+        VCPKG_DETECTED_CMAKE_LINKER
+        VCPKG_DETECTED_CMAKE_RANLIB
+    )
+        set(tool "${${var}}")
+        if(IS_ABSOLUTE "${tool}" AND EXISTS "${tool}")
+            file(REAL_PATH "${tool}" tool_real_path)
+            file(SIZE "${tool_real_path}" tool_size)
+            file(TIMESTAMP "${tool_real_path}" tool_timestamp "%Y-%m-%dT%H:%M:%S" UTC)
+            string(APPEND key_material "${var}=${tool}|${tool_size}|${tool_timestamp}\n")
+        else()
+            string(APPEND key_material "${var}=${tool}\n")
+        endif()
+    endforeach()
+
+    file(GLOB toolchain_files "${SCRIPTS}/toolchains/*.cmake")
+    list(SORT toolchain_files)
+    foreach(file IN LISTS CMAKE_TRIPLET_FILE VCPKG_CHAINLOAD_TOOLCHAIN_FILE toolchain_files)
+        if(EXISTS "${file}")
+            file(SHA256 "${file}" file_hash)
+            string(APPEND key_material "${file}=${file_hash}\n")
+        endif()
+    endforeach()
+
+    string(SHA256 key "${key_material}")
+    set("${out_var}" "${key}" PARENT_SCOPE)
+endfunction()
+
+# Seeds the cache file of the configure run in WORKING_DIRECTORY from the entry for KEY.
+# OUT_OPTIONS_VAR is set to the options passing the cache file to configure.
+function(z_vcpkg_autoconf_cache_restore)
+    cmake_parse_arguments(PARSE_ARGV 0 "arg" "" "KEY;WORKING_DIRECTORY;OUT_OPTIONS_VAR" "")
+
+    set("${arg_OUT_OPTIONS_VAR}" "" PARENT_SCOPE)
+    if("${arg_KEY}" STREQUAL "")
+        return()
+    endif()
+
+    set(cache_file "${arg_WORKING_DIRECTORY}/vcpkg-autoconf.cache")
+    set(entry "${VCPKG_AUTOCONF_CACHE_DIR}/${arg_KEY}.cache")
+    file(REMOVE "${cache_file}")
+    if(EXISTS "${entry}")
+        message(STATUS "Using cached autoconf results for ${TARGET_TRIPLET}")
+        file(COPY_FILE "${entry}" "${cache_file}")
+    endif()
+    set("${arg_OUT_OPTIONS_VAR}" "--cache-file=vcpkg-autoconf.cache" PARENT_SCOPE)
+endfunction()
+
+# Merges the shared results of the configure run in WORKING_DIRECTORY into the entry for KEY.
+# Concurrent builds may store the same key; entries are only replaced by renaming complete files,
+# so that a lost update merely drops results which the next port recomputes.
+function(z_vcpkg_autoconf_cache_store)
+    cmake_parse_arguments(PARSE_ARGV 0 "arg" "" "KEY;WORKING_DIRECTORY" "")
+
+    set(cache_file "${arg_WORKING_DIRECTORY}/vcpkg-autoconf.cache")
+    if("${arg_KEY}" STREQUAL "" OR NOT EXISTS "${cache_file}")
+        return()
+    endif()
+
+    set(entry "${VCPKG_AUTOCONF_CACHE_DIR}/${arg_KEY}.cache")
+    set(lines "")
+    set(variables "")
+    foreach(file IN ITEMS "${entry}" "${cache_file}")
+        if(NOT EXISTS "${file}")
+            continue()
+        endif()
+        file(STRINGS "${file}" file_lines REGEX "^(test \\$\\{)?[a-z]+_cv_[A-Za-z0-9_]+[=+]")
+        foreach(line IN LISTS file_lines)
+            if(NOT line MATCHES "^(test \\$\\{)?([a-z]+_cv_[A-Za-z0-9_]+)[=+]")
+                continue()
+            endif()
+            set(variable "${CMAKE_MATCH_2}")
+            if(variable IN_LIST variables)
+                continue()
+            endif()
+            # Values spanning several lines or containing list separators are not shared.
+            if(line MATCHES "[;[]" OR line MATCHES "]")
+                continue()
+            endif()
+            string(REGEX REPLACE "[^']" "" quotes "${line}")
+            string(LENGTH "${quotes}" quote_count)
+            math(EXPR quote_parity "${quote_count} % 2")
+            if(NOT quote_parity EQUAL 0)
+                continue()
+            endif()
+            foreach(regex IN LISTS Z_VCPKG_AUTOCONF_CACHE_SHARED_VARIABLES)
+                if(variable MATCHES "${regex}")
+                    list(APPEND variables "${variable}")
+                    string(APPEND lines "${line}\n")
+                    break()
+                endif()
+            endforeach()
+        endforeach()
+    endforeach()
+    if(lines STREQUAL "")
+        return()
+    endif()
+
+    string(RANDOM LENGTH 8 suffix)
+    set(staging "${entry}.${suffix}.tmp")
+    file(WRITE "${staging}" "# Shared autoconf results of ${TARGET_TRIPLET}, last updated by ${PORT}\n${lines}")
+    file(RENAME "${staging}" "${entry}" RESULT rename_result)
+    if(NOT rename_result STREQUAL "0")
+        file(REMOVE "${staging}")
+    endif()
+endfunction()
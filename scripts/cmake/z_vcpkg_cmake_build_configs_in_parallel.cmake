@@ -0,0 +1,78 @@
+# With VCPKG_BUILD_CONFIGS_IN_PARALLEL, vcpkg_cmake_build and vcpkg_build_cmake build the debug and
+# release configurations of Ninja and Makefile builds at once, splitting VCPKG_CONCURRENCY between them.
+
+# Builds both configurations in parallel when possible. Sets out_var to the build types which are
+# left to the sequential build: both when the parallel build is not used, else the failed ones.
+#
+# z_vcpkg_cmake_build_configs_in_parallel(<out-var>
+#     LOGFILE_BASE <base>
+#     [DISABLE_PARALLEL] [ADD_BIN_TO_PATH]
+#     [TARGET_ARGS <args>...]
+#     [BUILD_TOOL_ARGS <args>...]
+# )
+function(z_vcpkg_cmake_build_configs_in_parallel out_var)
+    cmake_parse_arguments(PARSE_ARGV 1 "arg" "DISABLE_PARALLEL;ADD_BIN_TO_PATH" "LOGFILE_BASE" "TARGET_ARGS;BUILD_TOOL_ARGS")
+    if(DEFINED arg_UNPARSED_ARGUMENTS)
+        message(FATAL_ERROR "${CMAKE_CURRENT_FUNCTION} was passed extra arguments: ${arg_UNPARSED_ARGUMENTS}")
+    endif()
+
+    set("${out_var}" debug release PARENT_SCOPE)
+    if(NOT VCPKG_BUILD_CONFIGS_IN_PARALLEL OR arg_DISABLE_PARALLEL OR DEFINED VCPKG_BUILD_TYPE
+        OR NOT Z_VCPKG_CMAKE_GENERATOR MATCHES "^(Ninja|Unix Makefiles)$" OR NOT VCPKG_CONCURRENCY GREATER "1")
+        return()
+    endif()
+    z_vcpkg_execute_build_process_parallel_supported(parallel_supported)
+    if(NOT parallel_supported)
+        message(STATUS "Building the configurations one after another, because no ninja is available")
+        return()
+    endif()
+
+    math(EXPR release_jobs "(${VCPKG_CONCURRENCY} + 1) / 2")
+    math(EXPR debug_jobs "${VCPKG_CONCURRENCY} / 2")
+    foreach(build_type IN ITEMS debug release)
+        if("${build_type}" STREQUAL "debug")
+            set(short_build_type "dbg")
+            set(config "Debug")
+        else()
+            set(short_build_type "rel")
+            set(config "Release")
+        endif()
+        vcpkg_list(SET "${short_build_type}_command"
+            "${CMAKE_COMMAND}" --build . --config "${config}" ${arg_TARGET_ARGS}
+            -- ${arg_BUILD_TOOL_ARGS} "-j${${build_type}_jobs}"
+        )
+        set("${short_build_type}_working_directory" "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-${short_build_type}")
+        set("${short_build_type}_logname" "${arg_LOGFILE_BASE}-${TARGET_TRIPLET}-${short_build_type}")
+        if(arg_ADD_BIN_TO_PATH)
+            vcpkg_backup_env_variables(VARS PATH)
+            if("${build_type}" STREQUAL "debug")
+                vcpkg_add_to_path(PREPEND "${CURRENT_INSTALLED_DIR}/debug/bin")
+            else()
+                vcpkg_add_to_path(PREPEND "${CURRENT_INSTALLED_DIR}/bin")
+            endif()
+            set("${short_build_type}_path" "$ENV{PATH}")
+            vcpkg_restore_env_variables(VARS PATH)
+        endif()
+    endforeach()
+
+    message(STATUS "Building ${TARGET_TRIPLET}-dbg and ${TARGET_TRIPLET}-rel in parallel")
+    z_vcpkg_execute_build_process_parallel(
+        PROCESSES dbg rel
+        WORKING_DIRECTORY "${CURRENT_BUILDTREES_DIR}/${TARGET_TRIPLET}-rel/vcpkg-parallel-build"
+        LOGNAME "${arg_LOGFILE_BASE}-${TARGET_TRIPLET}-parallel"
+        OUT_FAILED_VAR failed_short_build_types
+    )
+
+    # Failed configurations are built again on their own, with the usual retry handling.
+    set(build_types "")
+    if("dbg" IN_LIST failed_short_build_types)
+        list(APPEND build_types debug)
+    endif()
+    if("rel" IN_LIST failed_short_build_types)
+        list(APPEND build_types release)
+    endif()
+    if(NOT build_types STREQUAL "")
+        message(STATUS "Parallel build failed for ${failed_short_build_types}; building again without the other configuration")
+    endif()
+    set("${out_var}" "${build_types}" PARENT_SCOPE)
+endfunction()
@@ -0,0 +1,187 @@
+# Persistent cache for the outputs of vcpkg_cmake_get_vars and z_vcpkg_get_cmake_vars.
+# It is enabled by setting VCPKG_CMAKE_GET_VARS_CACHE_DIR, e.g. in the triplet file.
+
+# Computes the cache key for detecting the CMake variables of SOURCE_PATH.
+# Sets out_var to an empty string when the cache is disabled.
+function(z_vcpkg_cmake_get_vars_cache_key out_var)
+    cmake_parse_arguments(PARSE_ARGV 1 "arg" "" "SOURCE_PATH" "LANGUAGES")
+
+    if(DEFINED arg_UNPARSED_ARGUMENTS)
+        message(FATAL_ERROR "${CMAKE_CURRENT_FUNCTION} was passed extra arguments: ${arg_UNPARSED_ARGUMENTS}")
+    endif()
+    if(NOT DEFINED arg_SOURCE_PATH)
+        message(FATAL_ERROR "SOURCE_PATH must be specified.")
+    endif()
+
+    if("${VCPKG_CMAKE_GET_VARS_CACHE_DIR}" STREQUAL "")
+        set("${out_var}" "" PARENT_SCOPE)
+        return()
+    endif()
+
+    if(NOT DEFINED VCPKG_CHAINLOAD_TOOLCHAIN_FILE)
+        z_vcpkg_select_default_vcpkg_chainload_toolchain()
+    endif()
+
+    set(key_material "languages=${arg_LANGUAGES}\n")
+    foreach(var IN ITEMS
+        CMAKE_VERSION
+        TARGET_TRIPLET
+        HOST_TRIPLET
+        VCPKG_BUILD_TYPE
+        VCPKG_TARGET_ARCHITECTURE
+        VCPKG_TARGET_ISA_LEVEL
+        VCPKG_ENABLE_LTO
+        VCPKG_LTO_CACHE_DIR
+        VCPKG_CMAKE_SYSTEM_NAME
+        VCPKG_CMAKE_SYSTEM_VERSION
+        VCPKG_PLATFORM_TOOLSET
+        VCPKG_PLATFORM_TOOLSET_VERSION
+        VCPKG_XBOX_CONSOLE_TARGET
+        VCPKG_LIBRARY_LINKAGE
+        VCPKG_CRT_LINKAGE
+        VCPKG_CHAINLOAD_TOOLCHAIN_FILE
+        VCPKG_C_FLAGS VCPKG_C_FLAGS_DEBUG VCPKG_C_FLAGS_RELEASE
+        VCPKG_CXX_FLAGS VCPKG_CXX_FLAGS_DEBUG VCPKG_CXX_FLAGS_RELEASE
+        VCPKG_LINKER_FLAGS VCPKG_LINKER_FLAGS_DEBUG VCPKG_LINKER_FLAGS_RELEASE
+        VCPKG_INSTALL_NAME_DIR
+        VCPKG_OSX_DEPLOYMENT_TARGET
+        VCPKG_OSX_SYSROOT
+        VCPKG_OSX_ARCHITECTURES
+        VCPKG_CMAKE_CONFIGURE_OPTIONS VCPKG_CMAKE_CONFIGURE_OPTIONS_DEBUG VCPKG_CMAKE_CONFIGURE_OPTIONS_RELEASE
+        VCPKG_ROOT_DIR
+        _VCPKG_INSTALLED_DIR
+    )
+        string(APPEND key_material "${var}=${${var}}\n")
+    endforeach()
+
+    # The environment which the compiler detection and the generated files depend on.
+    foreach(env_var IN ITEMS
+        PATH INCLUDE C_INCLUDE_PATH CPLUS_INCLUDE_PATH CPATH LIB LIBPATH LIBRARY_PATH LD_LIBRARY_PATH
+        CC CXX ASM FC RC CFLAGS CXXFLAGS ASMFLAGS FFLAGS RCFLAGS LDFLAGS
+        SDKROOT MACOSX_DEPLOYMENT_TARGET
+        VisualStudioVersion VCToolsVersion WindowsSdkDir WindowsSDKVersion VSCMD_ARG_TGT_ARCH
+    )
+        string(APPEND key_material "ENV{${env_var}}=$ENV{${env_var}}\n")
+    endforeach()
+
+    file(GLOB toolchain_files "${SCRIPTS}/toolchains/*.cmake")
+    list(SORT toolchain_files)
+    foreach(file IN LISTS CMAKE_TRIPLET_FILE VCPKG_CHAINLOAD_TOOLCHAIN_FILE toolchain_files)
+        if(EXISTS "${file}")
+            file(SHA256 "${file}" file_hash)
+            string(APPEND key_material "${file}=${file_hash}\n")
+        endif()
+    endforeach()
+    file(GLOB_RECURSE source_files "${arg_SOURCE_PATH}/*" "${SCRIPTS}/buildsystems/vcpkg.cmake")
+    list(SORT source_files)
+    foreach(file IN LISTS source_files)
+        file(SHA256 "${file}" file_hash)
+        string(APPEND key_material "${file}=${file_hash}\n")
+    endforeach()
+
+    string(SHA256 key "${key_material}")
+    set("${out_var}" "${key}" PARENT_SCOPE)
+endfunction()
+
+# Computes the identity (path, size and timestamp) of the tools detected in FILES.
+function(z_vcpkg_cmake_get_vars_cache_tool_identity out_var)
+    cmake_parse_arguments(PARSE_ARGV 1 "arg" "" "" "FILES")
+
+    set(identity "")
+    foreach(file IN LISTS arg_FILES)
+        file(STRINGS "${file}" tool_lines REGEX "^set\\(VCPKG_DETECTED_CMAKE_(AR|LINKER|RANLIB|[A-Za-z]+_COMPILER) \"")
+        foreach(line IN LISTS tool_lines)
+            if(NOT line MATCHES "^set\\([A-Za-z_]+ \"(.*)\"\\)$")
+                continue()
+            endif()
+            # Undo the escaping of cmake_get_vars.
+            string(REGEX REPLACE "\\\\(.)" "\\1" tool "${CMAKE_MATCH_1}")
+            if(NOT IS_ABSOLUTE "${tool}" OR NOT EXISTS "${tool}")
+                continue()
+            endif()
+            file(REAL_PATH "${tool}" tool_real_path)
+            file(SIZE "${tool_real_path}" tool_size)
+            file(TIMESTAMP "${tool_real_path}" tool_timestamp "%Y-%m-%dT%H:%M:%S" UTC)
+            string(APPEND identity "${tool}|${tool_size}|${tool_timestamp}\n")
+        endforeach()
+    endforeach()
+    set("${out_var}" "${identity}" PARENT_SCOPE)
+endfunction()
+
+# Copies the cached files for KEY to the paths in FILES.
+# OUT_HIT_VAR is set to whether all files were restored.
+function(z_vcpkg_cmake_get_vars_cache_restore)
+    cmake_parse_arguments(PARSE_ARGV 0 "arg" "" "KEY;OUT_HIT_VAR" "FILES")
+
+    set("${arg_OUT_HIT_VAR}" OFF PARENT_SCOPE)
+    if("${arg_KEY}" STREQUAL "")
+        return()
+    endif()
+
+    set(entry "${VCPKG_CMAKE_GET_VARS_CACHE_DIR}/${arg_KEY}")
+    # Entries are published atomically, so the existence of the tool identity implies a complete entry.
+    if(NOT EXISTS "${entry}/tool-identity.txt")
+        return()
+    endif()
+
+    set(cached_files "")
+    foreach(file IN LISTS arg_FILES)
+        get_filename_component(file_name "${file}" NAME)
+        if(NOT EXISTS "${entry}/${file_name}")
+            return()
+        endif()
+        list(APPEND cached_files "${entry}/${file_name}")
+    endforeach()
+
+    # Updated compilers invalidate the entry.
+    file(READ "${entry}/tool-identity.txt" cached_identity)
+    z_vcpkg_cmake_get_vars_cache_tool_identity(current_identity FILES ${cached_files})
+    if(NOT "${current_identity}" STREQUAL "${cached_identity}")
+        message(STATUS "Ignoring cached CMake variables for ${TARGET_TRIPLET}: the detected tools changed")
+        return()
+    endif()
+
+    foreach(file cached_file IN ZIP_LISTS arg_FILES cached_files)
+        get_filename_component(file_dir "${file}" DIRECTORY)
+        file(COPY "${cached_file}" DESTINATION "${file_dir}")
+    endforeach()
+    message(STATUS "Using cached CMake variables for ${TARGET_TRIPLET}")
+    set("${arg_OUT_HIT_VAR}" ON PARENT_SCOPE)
+endfunction()
+
+# Stores FILES for KEY, replacing an entry whose tools changed.
+# Concurrent builds may store the same key; entries are only published by renaming complete,
+# non-empty directories, which fails when the destination already exists.
+function(z_vcpkg_cmake_get_vars_cache_store)
+    cmake_parse_arguments(PARSE_ARGV 0 "arg" "" "KEY" "FILES")
+
+    if("${arg_KEY}" STREQUAL "")
+        return()
+    endif()
+
+    set(entry "${VCPKG_CMAKE_GET_VARS_CACHE_DIR}/${arg_KEY}")
+    string(RANDOM LENGTH 8 suffix)
+    set(staging "${entry}.${suffix}.tmp")
+    file(REMOVE_RECURSE "${staging}")
+    file(MAKE_DIRECTORY "${staging}")
+    file(COPY ${arg_FILES} DESTINATION "${staging}")
+    z_vcpkg_cmake_get_vars_cache_tool_identity(identity FILES ${arg_FILES})
+    file(WRITE "${staging}/tool-identity.txt" "${identity}")
+
+    file(RENAME "${staging}" "${entry}" RESULT rename_result)
+    if(rename_result STREQUAL "0")
+        return()
+    endif()
+
+    set(cached_identity "")
+    if(EXISTS "${entry}/tool-identity.txt")
+        file(READ "${entry}/tool-identity.txt" cached_identity)
+    endif()
+    if(NOT "${cached_identity}" STREQUAL "${identity}")
+        # Move the outdated entry out of the way before deleting it, so that readers never see a partial entry.
+        file(RENAME "${entry}" "${entry}.${suffix}.old" RESULT rename_result)
+        file(REMOVE_RECURSE "${entry}.${suffix}.old")
+        file(RENAME "${staging}" "${entry}" RESULT rename_result)
+    endif()
+    file(REMOVE_RECURSE "${staging}")
+endfunction()
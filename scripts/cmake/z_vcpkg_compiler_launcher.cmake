@@ -0,0 +1,44 @@
+# Compiler launchers like ccache or sccache are enabled by setting VCPKG_COMPILER_LAUNCHER in the
+# triplet file, e.g. to "ccache" or to a list of a program and its arguments.
+# The Linux toolchain turns it into CMAKE_<LANG>_COMPILER_LAUNCHER, and the make and meson helpers
+# prepend it to the C and C++ compilers.
+
+# Maps the buildtrees and installed directories in the debug information to fixed paths, so that
+# the compiler cache can share objects between vcpkg roots. Called before the portfile.
+function(z_vcpkg_setup_compiler_launcher)
+    if("${VCPKG_COMPILER_LAUNCHER}" STREQUAL "")
+        return()
+    endif()
+    # cl does not support prefix maps.
+    if(VCPKG_TARGET_IS_WINDOWS AND NOT VCPKG_TARGET_IS_MINGW)
+        return()
+    endif()
+
+    cmake_path(GET CURRENT_BUILDTREES_DIR PARENT_PATH buildtrees_root)
+    if(NOT "${buildtrees_root}${_VCPKG_INSTALLED_DIR}" MATCHES " ")
+        foreach(flags_var IN ITEMS VCPKG_C_FLAGS VCPKG_CXX_FLAGS)
+            string(STRIP "${${flags_var}} -fdebug-prefix-map=${buildtrees_root}=/vcpkg/buildtrees -fdebug-prefix-map=${_VCPKG_INSTALLED_DIR}=/vcpkg/installed" flags)
+            set("${flags_var}" "${flags}" PARENT_SCOPE)
+        endforeach()
+    endif()
+
+    # ccache rewrites the absolute paths below its base directory to relative paths.
+    # It is the common ancestor of the buildtrees and the installed directory, unless that is the root.
+    list(GET VCPKG_COMPILER_LAUNCHER 0 launcher)
+    # sccache relies on the prefix maps alone.
+    if(launcher MATCHES "(^|[/\\\\])ccache(\\.exe)?\$" AND NOT DEFINED ENV{CCACHE_BASEDIR})
+        set(base_dir "${buildtrees_root}")
+        set(previous_dir "")
+        string(FIND "${_VCPKG_INSTALLED_DIR}/" "${base_dir}/" index)
+        while(NOT index EQUAL 0 AND NOT base_dir STREQUAL previous_dir)
+            set(previous_dir "${base_dir}")
+            cmake_path(GET base_dir PARENT_PATH base_dir)
+            string(FIND "${_VCPKG_INSTALLED_DIR}/" "${base_dir}/" index)
+        endwhile()
+        cmake_path(GET base_dir PARENT_PATH parent_dir)
+        if(NOT index EQUAL 0 OR parent_dir STREQUAL base_dir)
+            set(base_dir "${buildtrees_root}")
+        endif()
+        set(ENV{CCACHE_BASEDIR} "${base_dir}")
+    endif()
+endfunction()
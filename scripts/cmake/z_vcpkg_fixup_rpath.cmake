@@ -58,7 +58,8 @@ function(z_vcpkg_calculate_corrected_rpath)
     set("${arg_OUT_NEW_RPATH_VAR}" "${new_rpath}" PARENT_SCOPE)
 endfunction()
 
-function(z_vcpkg_fixup_rpath_in_dir)
+# Returns all ELF files in CURRENT_PACKAGES_DIR, detected by reading the ELF magic in-process.
+function(z_vcpkg_fixup_rpath_find_elf_files out_var)
     # We need to iterate trough everything because we
     # can't predict where an elf file will be located
     file(GLOB root_entries LIST_DIRECTORIES TRUE "${CURRENT_PACKAGES_DIR}/*")
@@ -68,12 +69,7 @@ function(z_vcpkg_fixup_rpath_in_dir)
     list(JOIN folders_to_skip "|" folders_to_skip_regex)
     set(folders_to_skip_regex "^(${folders_to_skip_regex})$")
 
-    # In download mode, we don't know if we're going to need PATCHELF, so be pessimistic and fetch
-    # it so it ends up in the downloads directory.
-    if(VCPKG_DOWNLOAD_MODE)
-        vcpkg_find_acquire_program(PATCHELF)
-    endif()
-
+    set(result "")
     foreach(folder IN LISTS root_entries)
         if(NOT IS_DIRECTORY "${folder}")
             continue()
@@ -92,9 +88,66 @@ function(z_vcpkg_fixup_rpath_in_dir)
             if(IS_SYMLINK "${elf_file}")
                 continue()
             endif()
+            file(READ "${elf_file}" magic LIMIT 4 HEX)
+            if(magic STREQUAL "7f454c46") # "\x7fELF"
+                list(APPEND result "${elf_file}")
+            endif()
+        endforeach()
+    endforeach()
+
+    set("${out_var}" "${result}" PARENT_SCOPE)
+endfunction()
 
-            vcpkg_find_acquire_program(PATCHELF) # Note that this relies on vcpkg_find_acquire_program short
-                                                 # circuiting after the first run
+# Reads the RPATH of each file in ELF_FILES with as few patchelf invocations as possible.
+# Files which patchelf cannot handle are dropped from OUT_ELF_FILES_VAR.
+function(z_vcpkg_fixup_rpath_read_rpaths)
+    cmake_parse_arguments(PARSE_ARGV 0 "arg"
+      ""
+      "BATCH_SIZE;OUT_ELF_FILES_VAR;OUT_RPATHS_PREFIX"
+      "ELF_FILES")
+
+    set(result_files "")
+    set(result_index 0)
+    set(index 0)
+    list(LENGTH arg_ELF_FILES count)
+    while(index LESS count)
+        list(SUBLIST arg_ELF_FILES "${index}" "${arg_BATCH_SIZE}" batch)
+        math(EXPR index "${index} + ${arg_BATCH_SIZE}")
+        list(LENGTH batch batch_count)
+
+        set(batch_ok FALSE)
+        if(batch_count GREATER "1")
+            execute_process(
+                COMMAND "${PATCHELF}" --print-rpath ${batch}
+                OUTPUT_VARIABLE readelf_output
+                ERROR_VARIABLE read_rpath_error
+                RESULT_VARIABLE read_rpath_result
+            )
+            if(read_rpath_result EQUAL "0" AND "${read_rpath_error}" STREQUAL "")
+                # patchelf prints exactly one line per file, in order.
+                string(REGEX REPLACE "\n$" "" readelf_output "${readelf_output}")
+                string(REPLACE "\n" ";" readelf_output "${readelf_output}")
+                list(LENGTH readelf_output output_count)
+                if(output_count EQUAL batch_count)
+                    set(batch_ok TRUE)
+                endif()
+            endif()
+        endif()
+
+        if(batch_ok)
+            set(output_index 0)
+            foreach(elf_file IN LISTS batch)
+                list(GET readelf_output "${output_index}" rpath)
+                math(EXPR output_index "${output_index} + 1")
+                list(APPEND result_files "${elf_file}")
+                set("${arg_OUT_RPATHS_PREFIX}_${result_index}" "${rpath}" PARENT_SCOPE)
+                math(EXPR result_index "${result_index} + 1")
+            endforeach()
+            continue()
+        endif()
+
+        # A single file of this batch is enough to make patchelf fail, so retry them one by one.
+        foreach(elf_file IN LISTS batch)
             # If this fails, the file is not an elf
             execute_process(
                 COMMAND "${PATCHELF}" --print-rpath "${elf_file}"
@@ -105,27 +158,129 @@ function(z_vcpkg_fixup_rpath_in_dir)
             if(NOT "${read_rpath_error}" STREQUAL "")
                 continue()
             endif()
+            list(APPEND result_files "${elf_file}")
+            set("${arg_OUT_RPATHS_PREFIX}_${result_index}" "${readelf_output}" PARENT_SCOPE)
+            math(EXPR result_index "${result_index} + 1")
+        endforeach()
+    endwhile()
 
-            get_filename_component(elf_file_dir "${elf_file}" DIRECTORY)
+    set("${arg_OUT_ELF_FILES_VAR}" "${result_files}" PARENT_SCOPE)
+endfunction()
 
-            z_vcpkg_calculate_corrected_rpath(
-              ELF_FILE_DIR "${elf_file_dir}"
-              ORG_RPATH "${readelf_output}"
-              OUT_NEW_RPATH_VAR new_rpath
-            )
+# Sets NEW_RPATH on each file in ELF_FILES with as few patchelf invocations as possible.
+# Files which couldn't be adjusted are returned in OUT_FAILED_VAR.
+function(z_vcpkg_fixup_rpath_write_rpath)
+    cmake_parse_arguments(PARSE_ARGV 0 "arg"
+      ""
+      "BATCH_SIZE;NEW_RPATH;OUT_FAILED_VAR"
+      "ELF_FILES")
+
+    set(failed "")
+    set(index 0)
+    list(LENGTH arg_ELF_FILES count)
+    while(index LESS count)
+        list(SUBLIST arg_ELF_FILES "${index}" "${arg_BATCH_SIZE}" batch)
+        math(EXPR index "${index} + ${arg_BATCH_SIZE}")
 
+        execute_process(
+            COMMAND "${PATCHELF}" --set-rpath "${arg_NEW_RPATH}" ${batch}
+            OUTPUT_QUIET
+            ERROR_VARIABLE set_rpath_error
+            RESULT_VARIABLE set_rpath_result
+        )
+        if(set_rpath_result EQUAL "0" AND "${set_rpath_error}" STREQUAL "")
+            continue()
+        endif()
+
+        # Find out which files are to blame.
+        foreach(elf_file IN LISTS batch)
             execute_process(
-                COMMAND "${PATCHELF}" --set-rpath "${new_rpath}" "${elf_file}"
+                COMMAND "${PATCHELF}" --set-rpath "${arg_NEW_RPATH}" "${elf_file}"
                 OUTPUT_QUIET
                 ERROR_VARIABLE set_rpath_error
             )
-
             if(NOT "${set_rpath_error}" STREQUAL "")
                 message(WARNING "Couldn't adjust RPATH of '${elf_file}': ${set_rpath_error}")
-                continue()
+                list(APPEND failed "${elf_file}")
             endif()
+        endforeach()
+    endwhile()
+
+    set("${arg_OUT_FAILED_VAR}" "${failed}" PARENT_SCOPE)
+endfunction()
+
+function(z_vcpkg_fixup_rpath_in_dir)
+    z_vcpkg_profile_begin(fixup z_vcpkg_fixup_rpath_in_dir)
+    # In download mode, we don't know if we're going to need PATCHELF, so be pessimistic and fetch
+    # it so it ends up in the downloads directory.
+    if(VCPKG_DOWNLOAD_MODE)
+        vcpkg_find_acquire_program(PATCHELF)
+    endif()
+
+    z_vcpkg_fixup_rpath_find_elf_files(elf_files)
+    if("${elf_files}" STREQUAL "")
+        z_vcpkg_profile_end(z_vcpkg_fixup_rpath_in_dir)
+        return()
+    endif()
 
-            message(STATUS "Adjusted RPATH of '${elf_file}' (From '${readelf_output}' -> To '${new_rpath}')")
+    vcpkg_find_acquire_program(PATCHELF)
+
+    # Keep the command lines well below the limits of all supported hosts.
+    set(batch_size 200)
+
+    z_vcpkg_fixup_rpath_read_rpaths(
+      ELF_FILES ${elf_files}
+      BATCH_SIZE "${batch_size}"
+      OUT_ELF_FILES_VAR elf_files
+      OUT_RPATHS_PREFIX org_rpath
+    )
+
+    # Group the files by their new RPATH, so that each distinct RPATH is set in a single batch.
+    set(new_rpaths "")
+    set(index 0)
+    foreach(elf_file IN LISTS elf_files)
+        get_filename_component(elf_file_dir "${elf_file}" DIRECTORY)
+        set(readelf_output "${org_rpath_${index}}")
+        math(EXPR index "${index} + 1")
+
+        # Files in the same directory usually share their original RPATH.
+        string(SHA1 key "${elf_file_dir}|${readelf_output}")
+        if(NOT DEFINED "z_vcpkg_rpath_cache_${key}")
+            z_vcpkg_calculate_corrected_rpath(
+              ELF_FILE_DIR "${elf_file_dir}"
+              ORG_RPATH "${readelf_output}"
+              OUT_NEW_RPATH_VAR "z_vcpkg_rpath_cache_${key}"
+            )
+        endif()
+        set(new_rpath "${z_vcpkg_rpath_cache_${key}}")
+
+        if("${new_rpath}" STREQUAL "${readelf_output}")
+            continue()
+        endif()
+
+        list(FIND new_rpaths "${new_rpath}" group)
+        if(group EQUAL "-1")
+            list(LENGTH new_rpaths group)
+            list(APPEND new_rpaths "${new_rpath}")
+        endif()
+        list(APPEND "group_${group}" "${elf_file}")
+        list(APPEND "group_${group}_messages" "Adjusted RPATH of '${elf_file}' (From '${readelf_output}' -> To '${new_rpath}')")
+    endforeach()
+
+    set(group 0)
+    foreach(new_rpath IN LISTS new_rpaths)
+        z_vcpkg_fixup_rpath_write_rpath(
+          ELF_FILES ${group_${group}}
+          NEW_RPATH "${new_rpath}"
+          BATCH_SIZE "${batch_size}"
+          OUT_FAILED_VAR failed_elf_files
+        )
+        foreach(elf_file adjusted_message IN ZIP_LISTS "group_${group}" "group_${group}_messages")
+            if(NOT elf_file IN_LIST failed_elf_files)
+                message(STATUS "${adjusted_message}")
+            endif()
         endforeach()
+        math(EXPR group "${group} + 1")
     endforeach()
+    z_vcpkg_profile_end(z_vcpkg_fixup_rpath_in_dir)
 endfunction()
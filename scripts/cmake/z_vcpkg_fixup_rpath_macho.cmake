@@ -40,6 +40,7 @@ function(z_vcpkg_regex_escape)
 endfunction()
 
 function(z_vcpkg_fixup_macho_rpath_in_dir)
+    z_vcpkg_profile_begin(fixup z_vcpkg_fixup_macho_rpath_in_dir)
     # We need to iterate through everything because we
     # can't predict where a Mach-O file will be located
     file(GLOB root_entries LIST_DIRECTORIES TRUE "${CURRENT_PACKAGES_DIR}/*")
@@ -240,4 +241,5 @@ function(z_vcpkg_fixup_macho_rpath_in_dir)
             endforeach()
         endforeach()
     endif()
+    z_vcpkg_profile_end(z_vcpkg_fixup_macho_rpath_in_dir)
 endfunction()
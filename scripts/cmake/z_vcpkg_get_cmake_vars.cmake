@@ -15,14 +15,26 @@ function(z_vcpkg_get_cmake_vars out_file)
     if(NOT DEFINED CACHE{${cache_var}})
         set(${cache_var}  "${cmake_vars_file}"
             CACHE PATH "The file to include to access the CMake variables from a generated project.")
-        vcpkg_configure_cmake(
-            SOURCE_PATH "${SCRIPTS}/get_cmake_vars"
-            OPTIONS_DEBUG "-DVCPKG_OUTPUT_FILE:PATH=${CURRENT_BUILDTREES_DIR}/cmake-vars-${TARGET_TRIPLET}-dbg.cmake.log"
-            OPTIONS_RELEASE "-DVCPKG_OUTPUT_FILE:PATH=${CURRENT_BUILDTREES_DIR}/cmake-vars-${TARGET_TRIPLET}-rel.cmake.log"
-            PREFER_NINJA
-            LOGNAME get-cmake-vars-${TARGET_TRIPLET}
-            Z_GET_CMAKE_VARS_USAGE # ignore vcpkg_cmake_configure, be quiet, don't set variables...
-        )
+        set(output_files "")
+        if(NOT DEFINED VCPKG_BUILD_TYPE OR VCPKG_BUILD_TYPE STREQUAL "release")
+            list(APPEND output_files "${CURRENT_BUILDTREES_DIR}/cmake-vars-${TARGET_TRIPLET}-rel.cmake.log")
+        endif()
+        if(NOT DEFINED VCPKG_BUILD_TYPE OR VCPKG_BUILD_TYPE STREQUAL "debug")
+            list(APPEND output_files "${CURRENT_BUILDTREES_DIR}/cmake-vars-${TARGET_TRIPLET}-dbg.cmake.log")
+        endif()
+        z_vcpkg_cmake_get_vars_cache_key(cache_key SOURCE_PATH "${SCRIPTS}/get_cmake_vars")
+        z_vcpkg_cmake_get_vars_cache_restore(KEY "${cache_key}" FILES ${output_files} OUT_HIT_VAR cache_hit)
+        if(NOT cache_hit)
+            vcpkg_configure_cmake(
+                SOURCE_PATH "${SCRIPTS}/get_cmake_vars"
+                OPTIONS_DEBUG "-DVCPKG_OUTPUT_FILE:PATH=${CURRENT_BUILDTREES_DIR}/cmake-vars-${TARGET_TRIPLET}-dbg.cmake.log"
+                OPTIONS_RELEASE "-DVCPKG_OUTPUT_FILE:PATH=${CURRENT_BUILDTREES_DIR}/cmake-vars-${TARGET_TRIPLET}-rel.cmake.log"
+                PREFER_NINJA
+                LOGNAME get-cmake-vars-${TARGET_TRIPLET}
+                Z_GET_CMAKE_VARS_USAGE # ignore vcpkg_cmake_configure, be quiet, don't set variables...
+            )
+            z_vcpkg_cmake_get_vars_cache_store(KEY "${cache_key}" FILES ${output_files})
+        endif()
 
         set(include_string "")
         if(NOT DEFINED VCPKG_BUILD_TYPE OR VCPKG_BUILD_TYPE STREQUAL "release")
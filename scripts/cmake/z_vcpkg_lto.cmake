@@ -0,0 +1,44 @@
+# Triplets for Linux can build the release configuration with link-time optimization by setting
+# VCPKG_ENABLE_LTO to thin or full. The Linux toolchain adds the flags once the compiler is known,
+# and selects the LTO-aware archivers (gcc-ar or llvm-ar); the make and meson helpers take both
+# from the toolchain. Debug builds are not affected.
+#
+# Clang uses -flto=thin or -flto=full, and ThinLTO links share the cache in VCPKG_LTO_CACHE_DIR,
+# which defaults to buildtrees/.lto-cache. GCC has no ThinLTO: thin uses the parallel WHOPR mode
+# and full a single partition. GCC objects keep regular code besides the LTO bytecode, so that
+# configure checks and consumers linking without LTO still work.
+#
+# Ports which fail with LTO can be listed in VCPKG_LTO_DENYLIST, or opt out in the portfile with
+# set(VCPKG_ENABLE_LTO OFF) before configuring.
+
+# Checks VCPKG_ENABLE_LTO and sets up VCPKG_LTO_CACHE_DIR. Called before the portfile.
+function(z_vcpkg_setup_lto)
+    if(NOT VCPKG_ENABLE_LTO)
+        return()
+    endif()
+    if(NOT VCPKG_ENABLE_LTO MATCHES "^(thin|full)$")
+        message(FATAL_ERROR "VCPKG_ENABLE_LTO must be thin, full or OFF, not ${VCPKG_ENABLE_LTO}")
+    endif()
+    if(NOT VCPKG_TARGET_IS_LINUX)
+        message(FATAL_ERROR "VCPKG_ENABLE_LTO is only supported for Linux triplets.")
+    endif()
+    if("${PORT}" IN_LIST VCPKG_LTO_DENYLIST)
+        message(STATUS "Link-time optimization is disabled for ${PORT}")
+        set(VCPKG_ENABLE_LTO OFF PARENT_SCOPE)
+        return()
+    endif()
+
+    if(NOT DEFINED VCPKG_LTO_CACHE_DIR)
+        cmake_path(GET CURRENT_BUILDTREES_DIR PARENT_PATH buildtrees_root)
+        set(VCPKG_LTO_CACHE_DIR "${buildtrees_root}/.lto-cache")
+    endif()
+    # The cache directory is passed within a linker option, which cannot be quoted reliably.
+    if(VCPKG_LTO_CACHE_DIR MATCHES " ")
+        message(WARNING "The ThinLTO cache is not used because its path contains spaces: ${VCPKG_LTO_CACHE_DIR}")
+        set(VCPKG_LTO_CACHE_DIR "")
+    endif()
+    if(NOT VCPKG_LTO_CACHE_DIR STREQUAL "")
+        file(MAKE_DIRECTORY "${VCPKG_LTO_CACHE_DIR}")
+    endif()
+    set(VCPKG_LTO_CACHE_DIR "${VCPKG_LTO_CACHE_DIR}" PARENT_SCOPE)
+endfunction()
@@ -0,0 +1,77 @@
+# Records the time spent in the phases of a port build when X_PORT_PROFILE is set.
+# The spans are appended to ${CURRENT_BUILDTREES_DIR}/profile-${TARGET_TRIPLET}.json in the
+# Chrome trace event format. The closing bracket of the event array is omitted, which trace
+# viewers accept, so that events can be appended as the spans end.
+
+function(z_vcpkg_profile_now out_var)
+    if(CMAKE_VERSION VERSION_LESS "3.23")
+        string(TIMESTAMP now "%s000000" UTC)
+    else()
+        string(TIMESTAMP now "%s%f" UTC)
+    endif()
+    set("${out_var}" "${now}" PARENT_SCOPE)
+endfunction()
+
+function(z_vcpkg_profile_json_escape out_var value)
+    string(REPLACE "\\" "\\\\" value "${value}")
+    string(REPLACE "\"" "\\\"" value "${value}")
+    string(REGEX REPLACE "[\r\n\t]" " " value "${value}")
+    set("${out_var}" "${value}" PARENT_SCOPE)
+endfunction()
+
+# Removes the profile of a previous build of the port.
+function(z_vcpkg_profile_reset)
+    if(NOT X_PORT_PROFILE)
+        return()
+    endif()
+    file(REMOVE "${CURRENT_BUILDTREES_DIR}/profile-${TARGET_TRIPLET}.json")
+    set_property(GLOBAL PROPERTY Z_VCPKG_PROFILE_STACK "")
+endfunction()
+
+# Starts a span NAME in the category PHASE, e.g. "configure" or "build".
+function(z_vcpkg_profile_begin phase name)
+    if(NOT X_PORT_PROFILE)
+        return()
+    endif()
+    z_vcpkg_profile_now(now)
+    string(REPLACE ";" "," name "${name}")
+    set_property(GLOBAL APPEND PROPERTY Z_VCPKG_PROFILE_STACK "${now}|${phase}|${name}")
+endfunction()
+
+# Ends the innermost span NAME, including the spans started inside it.
+function(z_vcpkg_profile_end name)
+    if(NOT X_PORT_PROFILE)
+        return()
+    endif()
+    z_vcpkg_profile_now(now)
+    string(REPLACE ";" "," name "${name}")
+    get_property(stack GLOBAL PROPERTY Z_VCPKG_PROFILE_STACK)
+    set(span "")
+    while(NOT "${stack}" STREQUAL "")
+        list(POP_BACK stack span)
+        if(span MATCHES "^[0-9]+\\|[^|]*\\|(.*)$")
+            if("${CMAKE_MATCH_1}" STREQUAL "${name}")
+                break()
+            endif()
+        endif()
+        set(span "")
+    endwhile()
+    set_property(GLOBAL PROPERTY Z_VCPKG_PROFILE_STACK "${stack}")
+    if(NOT span MATCHES "^([0-9]+)\\|([^|]*)\\|")
+        return()
+    endif()
+    set(start "${CMAKE_MATCH_1}")
+    set(phase "${CMAKE_MATCH_2}")
+    math(EXPR duration "${now} - ${start}")
+
+    # The port and triplet identify the process, so that the profiles of a whole run can be merged.
+    string(SHA1 pid "${PORT}|${TARGET_TRIPLET}")
+    string(SUBSTRING "${pid}" 0 7 pid)
+    math(EXPR pid "0x${pid}")
+    z_vcpkg_profile_json_escape(name "${name}")
+    set(profile_file "${CURRENT_BUILDTREES_DIR}/profile-${TARGET_TRIPLET}.json")
+    if(NOT EXISTS "${profile_file}")
+        file(WRITE "${profile_file}" "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":${pid},\"args\":{\"name\":\"${PORT}:${TARGET_TRIPLET}\"}},\n")
+    endif()
+    file(APPEND "${profile_file}" "{\"name\":\"${name}\",\"cat\":\"${phase}\",\"ph\":\"X\",\"ts\":${start},\"dur\":${duration},\"pid\":${pid},\"tid\":${pid},\"args\":{\"port\":\"${PORT}\",\"triplet\":\"${TARGET_TRIPLET}\",\"phase\":\"${phase}\"}},\n")
+endfunction()
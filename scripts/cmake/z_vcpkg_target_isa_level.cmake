@@ -0,0 +1,18 @@
+# Triplets for x64 Linux can raise the instruction set baseline of all compiled code by setting
+# VCPKG_TARGET_ISA_LEVEL to an x86-64 microarchitecture level: x86-64, x86-64-v2, x86-64-v3 (AVX2)
+# or x86-64-v4 (AVX-512). The Linux toolchain passes it to the compiler as -march, and the make and
+# meson helpers take it from the toolchain. Portfiles can read it to select a fixed target instead
+# of runtime dispatch. Being set in the triplet file, it is part of the ABI hash of every package.
+
+# Checks VCPKG_TARGET_ISA_LEVEL. Called before the portfile.
+function(z_vcpkg_check_target_isa_level)
+    if("${VCPKG_TARGET_ISA_LEVEL}" STREQUAL "")
+        return()
+    endif()
+    if(NOT VCPKG_TARGET_ISA_LEVEL MATCHES "^x86-64(-v[234])?$")
+        message(FATAL_ERROR "VCPKG_TARGET_ISA_LEVEL must be one of x86-64, x86-64-v2, x86-64-v3 or x86-64-v4, not ${VCPKG_TARGET_ISA_LEVEL}")
+    endif()
+    if(NOT VCPKG_TARGET_ARCHITECTURE STREQUAL "x64" OR NOT VCPKG_TARGET_IS_LINUX)
+        message(FATAL_ERROR "VCPKG_TARGET_ISA_LEVEL is only supported for x64 Linux triplets.")
+    endif()
+endfunction()
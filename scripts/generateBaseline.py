@@ -3,9 +3,12 @@ import sys
 import json
 import time
 
+import multiprocessing
+
 from pathlib import Path
 
 
+MAX_PROCESSES = multiprocessing.cpu_count()
 SCRIPT_DIRECTORY = os.path.dirname(os.path.abspath(__file__))
 PORTS_DIRECTORY = os.path.join(SCRIPT_DIRECTORY, '../ports')
 VERSIONS_DB_DIRECTORY = os.path.join(SCRIPT_DIRECTORY, '../versions')
@@ -29,42 +32,63 @@ def get_version_port_version(version):
     return 0
 
 
-def generate_baseline():
-    start_time = time.time()
+def get_baseline_entry(port_name):
+    port_file_path = os.path.join(
+        VERSIONS_DB_DIRECTORY, f'{port_name[0]}-', f'{port_name}.json')
 
-    # Assume each directory in ${VCPKG_ROOT}/ports is a different port
-    port_names = [item for item in os.listdir(
-        PORTS_DIRECTORY) if os.path.isdir(os.path.join(PORTS_DIRECTORY, item))]
-    port_names.sort()
+    if not os.path.exists(port_file_path):
+        # Removed ports have no version file anymore
+        if os.path.isdir(os.path.join(PORTS_DIRECTORY, port_name)):
+            print(
+                f'Error: No version file for {port_name}.\n', file=sys.stderr)
+        return port_name, None
+    with open(port_file_path, 'r') as db_file:
+        try:
+            versions_object = json.load(db_file)
+            if versions_object['versions']:
+                last_version = versions_object['versions'][0]
+                return port_name, {
+                    'baseline': get_version_tag(last_version),
+                    'port-version': get_version_port_version(last_version)
+                }
+        except json.JSONDecodeError as e:
+            print(f'Error: Decoding {port_file_path}\n{e}\n')
+    return port_name, None
+
+
+def generate_baseline(changed_ports=None):
+    """Writes baseline.json from the version files.
+
+    When changed_ports is given, only the entries of these ports are updated
+    in the existing baseline.json.
+    """
+    start_time = time.time()
 
+    baseline_path = os.path.join(VERSIONS_DB_DIRECTORY, 'baseline.json')
     baseline_entries = {}
-    total_count = len(port_names)
-    for i, port_name in enumerate(port_names, 1):
-        port_file_path = os.path.join(
-            VERSIONS_DB_DIRECTORY, f'{port_name[0]}-', f'{port_name}.json')
+    if changed_ports is not None and os.path.exists(baseline_path):
+        with open(baseline_path, 'r') as baseline_file:
+            baseline_entries = json.load(baseline_file)['default']
+        port_names = sorted(changed_ports)
+    else:
+        # Assume each directory in ${VCPKG_ROOT}/ports is a different port
+        port_names = [item for item in os.listdir(
+            PORTS_DIRECTORY) if os.path.isdir(os.path.join(PORTS_DIRECTORY, item))]
+        port_names.sort()
 
-        if not os.path.exists(port_file_path):
-            print(
-                f'Error: No version file for {port_name}.\n', file=sys.stderr)
-            continue
-        sys.stderr.write(
-            f'\rProcessed {i}/{total_count} ({i/total_count:.2%})')
-        with open(port_file_path, 'r') as db_file:
-            try:
-                versions_object = json.load(db_file)
-                if versions_object['versions']:
-                    last_version = versions_object['versions'][0]
-                    baseline_entries[port_name] = {
-                        'baseline': get_version_tag(last_version),
-                        'port-version': get_version_port_version(last_version)
-                    }
-            except json.JSONDecodeError as e:
-                print(f'Error: Decoding {port_file_path}\n{e}\n')
+    total_count = len(port_names)
+    with multiprocessing.Pool(MAX_PROCESSES) as process_pool:
+        for i, (port_name, entry) in enumerate(process_pool.imap(get_baseline_entry, port_names, chunksize=64), 1):
+            sys.stderr.write(
+                f'\rProcessed {i}/{total_count} ({i/total_count:.2%})')
+            if entry is None:
+                baseline_entries.pop(port_name, None)
+            else:
+                baseline_entries[port_name] = entry
     baseline_object = {}
-    baseline_object['default'] = baseline_entries
+    baseline_object['default'] = dict(sorted(baseline_entries.items()))
 
     os.makedirs(VERSIONS_DB_DIRECTORY, exist_ok=True)
-    baseline_path = os.path.join(VERSIONS_DB_DIRECTORY, 'baseline.json')
     with open(baseline_path, 'w') as baseline_file:
         json.dump(baseline_object, baseline_file)
 
@@ -1,19 +1,24 @@
 import os
+import re
 import sys
 import subprocess
 import json
 import time
 import shutil
 
+import argparse
 import multiprocessing
 
 from pathlib import Path
 
+import generateBaseline
+
 
 MAX_PROCESSES = multiprocessing.cpu_count()
 SCRIPT_DIRECTORY = os.path.dirname(os.path.abspath(__file__))
 PORTS_DIRECTORY = os.path.join(SCRIPT_DIRECTORY, '../ports')
 VERSIONS_DB_DIRECTORY = os.path.join(SCRIPT_DIRECTORY, '../versions')
+REVISION_STAMP_PATTERN = re.compile('^[0-9a-f]{40}$')
 
 
 def get_current_git_ref():
@@ -26,7 +31,39 @@ def get_current_git_ref():
     return None
 
 
+def get_last_revision():
+    """Returns the newest revision stamp in the versions directory which is an ancestor of HEAD."""
+    stamps = [item for item in os.listdir(VERSIONS_DB_DIRECTORY)
+              if REVISION_STAMP_PATTERN.match(item) and os.path.isfile(os.path.join(VERSIONS_DB_DIRECTORY, item))]
+    stamps.sort(key=lambda item: os.path.getmtime(
+        os.path.join(VERSIONS_DB_DIRECTORY, item)), reverse=True)
+    for stamp in stamps:
+        output = subprocess.run(['git', '-C', SCRIPT_DIRECTORY, 'merge-base', '--is-ancestor', stamp, 'HEAD'],
+                                capture_output=True)
+        if output.returncode == 0:
+            return stamp
+    return None
+
+
+def get_changed_ports(last_revision, revision):
+    # Without rename detection, moved ports also report their old paths, so that those are cleaned up
+    output = subprocess.run(['git', '-C', SCRIPT_DIRECTORY, 'diff', '--name-only', '--no-renames', last_revision, revision, '--', ':(top)ports/'],
+                            capture_output=True,
+                            encoding='utf-8')
+    if output.returncode != 0:
+        print(f"Failed to diff {last_revision}..{revision}:",
+              output.stderr.strip(), file=sys.stderr)
+        return None
+    changed_ports = set()
+    for line in output.stdout.splitlines():
+        parts = line.split('/')
+        if len(parts) > 2 and parts[0] == 'ports':
+            changed_ports.add(parts[1])
+    return changed_ports
+
+
 def generate_versions_file(port_name):
+    """Returns the port name if its history could not be generated."""
     containing_dir = os.path.join(VERSIONS_DB_DIRECTORY, f'{port_name[0]}-')
     os.makedirs(containing_dir, exist_ok=True)
 
@@ -41,35 +78,102 @@ def generate_versions_file(port_name):
         if output.returncode != 0:
             print(f'x-history {port_name} failed: ',
                   output.stdout.strip(), file=sys.stderr)
+            return port_name
+    return None
 
 
-def generate_versions_db(revision):
+def regenerate_versions_file(port_name):
+    """Returns the port name if its history could not be generated."""
+    output_file_path = os.path.join(
+        VERSIONS_DB_DIRECTORY, f'{port_name[0]}-', f'{port_name}.json')
+    if not os.path.isdir(os.path.join(PORTS_DIRECTORY, port_name)):
+        # The port was removed
+        if os.path.exists(output_file_path):
+            os.remove(output_file_path)
+        return None
+    # Keep the previous file until the new history was written successfully
+    temp_file_path = f'{output_file_path}.tmp'
+    env = os.environ.copy()
+    env['GIT_OPTIONAL_LOCKS'] = '0'
+    os.makedirs(os.path.dirname(output_file_path), exist_ok=True)
+    output = subprocess.run(
+        [os.path.join(SCRIPT_DIRECTORY, '../vcpkg'),
+         'x-history', port_name, '--x-json', f'--output={temp_file_path}'],
+        capture_output=True, encoding='utf-8', env=env)
+    if output.returncode != 0:
+        print(f'x-history {port_name} failed: ',
+              output.stdout.strip(), file=sys.stderr)
+        if os.path.exists(temp_file_path):
+            os.remove(temp_file_path)
+        return port_name
+    os.replace(temp_file_path, output_file_path)
+    return None
+
+
+def generate_versions_db(revision, last_revision=None):
     start_time = time.time()
 
-    # Assume each directory in ${VCPKG_ROOT}/ports is a different port
-    port_names = [item for item in os.listdir(
-        PORTS_DIRECTORY) if os.path.isdir(os.path.join(PORTS_DIRECTORY, item))]
+    changed_ports = None
+    if last_revision:
+        phase_start_time = time.time()
+        changed_ports = get_changed_ports(last_revision, revision)
+        print(
+            f'Finding changed ports: {time.time() - phase_start_time:.2f} seconds')
+
+    if changed_ports is None:
+        # Assume each directory in ${VCPKG_ROOT}/ports is a different port
+        port_names = [item for item in os.listdir(
+            PORTS_DIRECTORY) if os.path.isdir(os.path.join(PORTS_DIRECTORY, item))]
+        generate_function = generate_versions_file
+    else:
+        print(f'Updating {len(changed_ports)} ports changed since {last_revision}')
+        port_names = sorted(changed_ports)
+        generate_function = regenerate_versions_file
     total_count = len(port_names)
 
-    concurrency = MAX_PROCESSES / 2
-    print(f'Running {concurrency:.0f} parallel processes')
+    phase_start_time = time.time()
+    print(f'Running {MAX_PROCESSES} parallel processes')
     process_pool = multiprocessing.Pool(MAX_PROCESSES)
-    for i, _ in enumerate(process_pool.imap_unordered(generate_versions_file, port_names), 1):
+    failed_ports = []
+    for i, failed_port in enumerate(process_pool.imap_unordered(generate_function, port_names), 1):
+        if failed_port:
+            failed_ports.append(failed_port)
         sys.stderr.write(
             f'\rProcessed: {i}/{total_count} ({(i / total_count):.2%})')
     process_pool.close()
     process_pool.join()
+    print(
+        f'\nGenerating version files: {time.time() - phase_start_time:.2f} seconds')
 
-    # Generate timestamp
-    rev_file = os.path.join(VERSIONS_DB_DIRECTORY, revision)
-    Path(rev_file).touch()
+    if changed_ports is not None:
+        print('Updating baseline')
+        generateBaseline.generate_baseline(changed_ports)
+
+    # Keep the previous revision stamp, so that the next run retries the failed ports
+    if failed_ports:
+        print(f'Failed to generate the version files of {len(failed_ports)} ports: {", ".join(sorted(failed_ports))}',
+              file=sys.stderr)
+    else:
+        if changed_ports is not None:
+            os.remove(os.path.join(VERSIONS_DB_DIRECTORY, last_revision))
+
+        # Generate timestamp
+        rev_file = os.path.join(VERSIONS_DB_DIRECTORY, revision)
+        Path(rev_file).touch()
 
     elapsed_time = time.time() - start_time
     print(
-        f'\nElapsed time: {elapsed_time:.2f} seconds')
+        f'Elapsed time: {elapsed_time:.2f} seconds')
+    return not failed_ports
 
 
 def main():
+    parser = argparse.ArgumentParser(
+        description='Generates the version files for all ports.')
+    parser.add_argument('--full', action='store_true',
+                        help='Ignore the revision stamps of previous runs and check every port.')
+    args = parser.parse_args()
+
     revision = get_current_git_ref()
     if not revision:
         print('Couldn\'t fetch current Git revision', file=sys.stderr)
@@ -80,7 +184,11 @@ def main():
         print(f'Database files already exist for commit {revision}')
         sys.exit(0)
 
-    generate_versions_db(revision)
+    last_revision = None
+    if not args.full and os.path.isdir(VERSIONS_DB_DIRECTORY):
+        last_revision = get_last_revision()
+    if not generate_versions_db(revision, last_revision):
+        sys.exit(1)
 
 
 if __name__ == "__main__":
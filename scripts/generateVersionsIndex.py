@@ -0,0 +1,272 @@
+import os
+import sys
+import json
+import mmap
+import random
+import struct
+import time
+import argparse
+
+
+SCRIPT_DIRECTORY = os.path.dirname(os.path.abspath(__file__))
+VERSIONS_DB_DIRECTORY = os.path.join(SCRIPT_DIRECTORY, '../versions')
+DEFAULT_INDEX_PATH = os.path.join(VERSIONS_DB_DIRECTORY, 'versions.idx')
+
+# Layout of the index; all integers are little-endian.
+#
+#   header:  magic, format version, port count, offsets of the port, record and string tables
+#   ports:   one entry per port, sorted by the UTF-8 bytes of the name:
+#            name offset, name length, baseline offset, baseline length, baseline port-version,
+#            first record, record count
+#   records: one entry per element of the "versions" array of the port's version file, in order:
+#            git-tree (20 raw bytes), version offset, version length, port-version, scheme, flags
+#   strings: UTF-8 bytes referenced by (offset, length) pairs, relative to the start of the table
+#
+# A port without a baseline entry has NO_BASELINE as baseline offset.
+MAGIC = b'VCPKGVIX'
+FORMAT_VERSION = 1
+HEADER = struct.Struct('<8sIIIII')
+PORT = struct.Struct('<IIIIIII')
+RECORD = struct.Struct('<20sIIIBBxx')
+NO_BASELINE = 0xFFFFFFFF
+SCHEMES = ['version', 'version-semver', 'version-date', 'version-string']
+FLAG_HAS_PORT_VERSION = 1
+
+
+def load_json_sources(versions_directory):
+    with open(os.path.join(versions_directory, 'baseline.json'), 'r', encoding='utf-8') as baseline_file:
+        baseline = json.load(baseline_file)['default']
+    port_versions = {}
+    for item in os.listdir(versions_directory):
+        containing_dir = os.path.join(versions_directory, item)
+        if not item.endswith('-') or not os.path.isdir(containing_dir):
+            continue
+        for file_name in os.listdir(containing_dir):
+            if not file_name.endswith('.json'):
+                continue
+            with open(os.path.join(containing_dir, file_name), 'r', encoding='utf-8') as db_file:
+                port_versions[file_name[:-len('.json')]] = json.load(db_file)['versions']
+    return baseline, port_versions
+
+
+def get_scheme(version):
+    for scheme_index, scheme in enumerate(SCHEMES):
+        if scheme in version:
+            return scheme_index, version[scheme]
+    raise ValueError(f'No version field in {version}')
+
+
+def build_index(baseline, port_versions):
+    strings = bytearray()
+    string_offsets = {}
+
+    def add_string(value):
+        data = value.encode('utf-8')
+        if data not in string_offsets:
+            string_offsets[data] = len(strings)
+            strings.extend(data)
+        return string_offsets[data], len(data)
+
+    port_names = sorted(set(baseline) | set(port_versions),
+                        key=lambda name: name.encode('utf-8'))
+    ports = bytearray()
+    records = bytearray()
+    record_count = 0
+    for port_name in port_names:
+        name_offset, name_length = add_string(port_name)
+        if port_name in baseline:
+            baseline_offset, baseline_length = add_string(
+                baseline[port_name]['baseline'])
+            baseline_port_version = baseline[port_name].get('port-version', 0)
+        else:
+            baseline_offset, baseline_length, baseline_port_version = NO_BASELINE, 0, 0
+
+        first_record = record_count
+        for version in port_versions.get(port_name, []):
+            scheme, version_text = get_scheme(version)
+            version_offset, version_length = add_string(version_text)
+            flags = FLAG_HAS_PORT_VERSION if 'port-version' in version else 0
+            records.extend(RECORD.pack(bytes.fromhex(version['git-tree']), version_offset, version_length,
+                                       version.get('port-version', 0), scheme, flags))
+            record_count += 1
+        ports.extend(PORT.pack(name_offset, name_length, baseline_offset, baseline_length,
+                               baseline_port_version, first_record, record_count - first_record))
+
+    port_table_offset = HEADER.size
+    record_table_offset = port_table_offset + len(ports)
+    string_table_offset = record_table_offset + len(records)
+    header = HEADER.pack(MAGIC, FORMAT_VERSION, len(port_names),
+                         port_table_offset, record_table_offset, string_table_offset)
+    return header + bytes(ports) + bytes(records) + bytes(strings)
+
+
+class VersionsIndex:
+    """Reads an index written by this script without loading it into memory."""
+
+    def __init__(self, path):
+        with open(path, 'rb') as index_file:
+            self.data = mmap.mmap(index_file.fileno(), 0, access=mmap.ACCESS_READ)
+        magic, format_version, self.port_count, self.port_table_offset, self.record_table_offset, \
+            self.string_table_offset = HEADER.unpack_from(self.data, 0)
+        if magic != MAGIC or format_version != FORMAT_VERSION:
+            raise ValueError(f'{path} is not a versions index of format {FORMAT_VERSION}')
+
+    def close(self):
+        self.data.close()
+
+    def _string(self, offset, length):
+        start = self.string_table_offset + offset
+        return self.data[start:start + length]
+
+    def _port(self, index):
+        return PORT.unpack_from(self.data, self.port_table_offset + index * PORT.size)
+
+    def _find_port(self, port_name):
+        key = port_name.encode('utf-8')
+        low, high = 0, self.port_count
+        while low < high:
+            middle = (low + high) // 2
+            port = self._port(middle)
+            name = self._string(port[0], port[1])
+            if name < key:
+                low = middle + 1
+            elif name > key:
+                high = middle
+            else:
+                return port
+        return None
+
+    def port_names(self):
+        for index in range(self.port_count):
+            port = self._port(index)
+            yield self._string(port[0], port[1]).decode('utf-8')
+
+    def baseline(self, port_name):
+        """Returns the baseline entry of port_name as in baseline.json, or None."""
+        port = self._find_port(port_name)
+        if port is None or port[2] == NO_BASELINE:
+            return None
+        return {
+            'baseline': self._string(port[2], port[3]).decode('utf-8'),
+            'port-version': port[4]
+        }
+
+    def versions(self, port_name):
+        """Returns the "versions" array of the version file of port_name, or None."""
+        port = self._find_port(port_name)
+        if port is None:
+            return None
+        versions = []
+        for index in range(port[5], port[5] + port[6]):
+            git_tree, version_offset, version_length, port_version, scheme, flags = RECORD.unpack_from(
+                self.data, self.record_table_offset + index * RECORD.size)
+            version = {
+                'git-tree': git_tree.hex(),
+                SCHEMES[scheme]: self._string(version_offset, version_length).decode('utf-8')
+            }
+            if flags & FLAG_HAS_PORT_VERSION:
+                version['port-version'] = port_version
+            versions.append(version)
+        return versions
+
+
+def generate_index(versions_directory, index_path):
+    start_time = time.time()
+    baseline, port_versions = load_json_sources(versions_directory)
+    index = build_index(baseline, port_versions)
+    temp_path = f'{index_path}.tmp'
+    with open(temp_path, 'wb') as index_file:
+        index_file.write(index)
+    os.replace(temp_path, index_path)
+    elapsed_time = time.time() - start_time
+    print(f'Wrote {len(index)} bytes for {len(set(baseline) | set(port_versions))} ports to {index_path}')
+    print(f'Elapsed time: {elapsed_time:.2f} seconds')
+
+
+def check_index(versions_directory, index_path):
+    baseline, port_versions = load_json_sources(versions_directory)
+    index = VersionsIndex(index_path)
+    errors = 0
+    expected_names = sorted(set(baseline) | set(port_versions),
+                            key=lambda name: name.encode('utf-8'))
+    if list(index.port_names()) != expected_names:
+        print('Error: The ports of the index do not match the JSON files', file=sys.stderr)
+        errors += 1
+    for port_name in expected_names:
+        expected_baseline = baseline.get(port_name)
+        if expected_baseline is not None:
+            expected_baseline = {
+                'baseline': expected_baseline['baseline'],
+                'port-version': expected_baseline.get('port-version', 0)
+            }
+        if index.baseline(port_name) != expected_baseline:
+            print(f'Error: Baseline mismatch for {port_name}', file=sys.stderr)
+            errors += 1
+        if index.versions(port_name) != port_versions.get(port_name, []):
+            print(f'Error: Versions mismatch for {port_name}', file=sys.stderr)
+            errors += 1
+    if index.baseline('z-vcpkg-no-such-port') is not None:
+        print('Error: Lookup of a missing port succeeded', file=sys.stderr)
+        errors += 1
+    index.close()
+    if errors:
+        print(f'{errors} errors found in {index_path}', file=sys.stderr)
+        return False
+    print(f'{index_path} matches {len(expected_names)} ports of {versions_directory}')
+    return True
+
+
+def benchmark_index(versions_directory, index_path, lookups):
+    with open(os.path.join(versions_directory, 'baseline.json'), 'r', encoding='utf-8') as baseline_file:
+        port_names = list(json.load(baseline_file)['default'])
+    random.seed(0)
+    sample = [random.choice(port_names) for _ in range(lookups)]
+
+    start_time = time.perf_counter()
+    for port_name in sample:
+        with open(os.path.join(versions_directory, 'baseline.json'), 'r', encoding='utf-8') as baseline_file:
+            json.load(baseline_file)['default'].get(port_name)
+        with open(os.path.join(versions_directory, f'{port_name[0]}-', f'{port_name}.json'), 'r', encoding='utf-8') as db_file:
+            json.load(db_file)['versions']
+    json_time = time.perf_counter() - start_time
+
+    start_time = time.perf_counter()
+    for port_name in sample:
+        index = VersionsIndex(index_path)
+        index.baseline(port_name)
+        index.versions(port_name)
+        index.close()
+    index_time = time.perf_counter() - start_time
+
+    print(f'{lookups} lookups of baseline and versions of a port, opening the sources each time:')
+    print(f'  json.load: {json_time / lookups * 1e6:10.1f} us per lookup')
+    print(f'  index:     {index_time / lookups * 1e6:10.1f} us per lookup')
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Generates a binary index of the baseline and version files, which can be memory mapped.')
+    parser.add_argument('--versions-directory', default=VERSIONS_DB_DIRECTORY,
+                        help='The versions directory containing baseline.json.')
+    parser.add_argument('--output', default=DEFAULT_INDEX_PATH,
+                        help='The path of the index.')
+    parser.add_argument('--check', action='store_true',
+                        help='Check that an existing index matches the JSON files instead of generating it.')
+    parser.add_argument('--benchmark', type=int, metavar='LOOKUPS',
+                        help='Compare the lookup time of an existing index with json.load.')
+    args = parser.parse_args()
+
+    if not os.path.exists(os.path.join(args.versions_directory, 'baseline.json')):
+        print(f'Version DB files must exist before generating an index.\nRun: `python generateBaseline.py`\n')
+        sys.exit(1)
+
+    if args.check:
+        sys.exit(0 if check_index(args.versions_directory, args.output) else 1)
+    elif args.benchmark:
+        benchmark_index(args.versions_directory, args.output, args.benchmark)
+    else:
+        generate_index(args.versions_directory, args.output)
+
+
+if __name__ == "__main__":
+    main()
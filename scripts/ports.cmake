@@ -91,11 +91,18 @@ include("${SCRIPTS}/cmake/vcpkg_replace_string.cmake")
 include("${SCRIPTS}/cmake/vcpkg_test_cmake.cmake")
 
 include("${SCRIPTS}/cmake/z_vcpkg_apply_patches.cmake")
+include("${SCRIPTS}/cmake/z_vcpkg_autoconf_cache.cmake")
+include("${SCRIPTS}/cmake/z_vcpkg_cmake_build_configs_in_parallel.cmake")
+include("${SCRIPTS}/cmake/z_vcpkg_cmake_get_vars_cache.cmake")
+include("${SCRIPTS}/cmake/z_vcpkg_compiler_launcher.cmake")
 include("${SCRIPTS}/cmake/z_vcpkg_forward_output_variable.cmake")
 include("${SCRIPTS}/cmake/z_vcpkg_function_arguments.cmake")
 include("${SCRIPTS}/cmake/z_vcpkg_get_cmake_vars.cmake")
+include("${SCRIPTS}/cmake/z_vcpkg_lto.cmake")
 include("${SCRIPTS}/cmake/z_vcpkg_prettify_command_line.cmake")
+include("${SCRIPTS}/cmake/z_vcpkg_profile.cmake")
 include("${SCRIPTS}/cmake/z_vcpkg_setup_pkgconfig_path.cmake")
+include("${SCRIPTS}/cmake/z_vcpkg_target_isa_level.cmake")
 
 include("${SCRIPTS}/cmake/z_vcpkg_fixup_rpath.cmake")
 include("${SCRIPTS}/cmake/z_vcpkg_fixup_rpath_macho.cmake")
@@ -203,7 +210,14 @@ target system or to the host system. Use a prefixed variable instead.
     set(Z_VCPKG_ERROR_LOG_COLLECTION_FILE "${CURRENT_BUILDTREES_DIR}/error-logs-${TARGET_TRIPLET}.txt")
     file(REMOVE "${Z_VCPKG_ERROR_LOG_COLLECTION_FILE}")
 
+    z_vcpkg_check_target_isa_level()
+    z_vcpkg_setup_lto()
+    z_vcpkg_setup_compiler_launcher()
+
+    z_vcpkg_profile_reset()
+    z_vcpkg_profile_begin(portfile "${PORT}")
     include("${CURRENT_PORT_DIR}/portfile.cmake")
+    z_vcpkg_profile_end("${PORT}")
 
     foreach(z_post_portfile_include IN LISTS Z_VCPKG_POST_PORTFILE_INCLUDES)
         include("${z_post_portfile_include}")
@@ -0,0 +1,241 @@
+import os
+import sys
+import json
+import time
+import hashlib
+import tempfile
+import argparse
+import threading
+import subprocess
+import http.client
+import urllib.error
+import urllib.parse
+import urllib.request
+
+from concurrent.futures import ThreadPoolExecutor
+
+
+SCRIPT_DIRECTORY = os.path.dirname(os.path.abspath(__file__))
+DEFAULT_VCPKG = os.path.join(SCRIPT_DIRECTORY, '..', 'vcpkg.exe' if os.name == 'nt' else 'vcpkg')
+CHUNK_SIZE = 1 << 20
+# vcpkg_download_distfile waits while a marker was touched within the last minute.
+HEARTBEAT_SECONDS = 10
+CONNECT_TIMEOUT_SECONDS = 60
+
+# Runs the download mode pass of vcpkg install for the given arguments, and prefetches the distfiles
+# it would download concurrently with the actual vcpkg install. vcpkg_download_distfile waits for
+# files which are still being prefetched, so that each port is built as soon as its files are present.
+#
+# The download mode pass only records the downloads in a queue file (see VCPKG_PREFETCH_QUEUE in
+# scripts/cmake/vcpkg_download_distfile.cmake). Each file is downloaded from the first of its URLs
+# which works and checked against its SHA512 while it is written. Failed prefetches are left to
+# vcpkg install, which reports them.
+
+
+def record_downloads(vcpkg, install_args, queue_path):
+    env = os.environ.copy()
+    env['VCPKG_PREFETCH_QUEUE'] = queue_path
+    keep_env_vars = env.get('VCPKG_KEEP_ENV_VARS', '')
+    env['VCPKG_KEEP_ENV_VARS'] = f'{keep_env_vars};VCPKG_PREFETCH_QUEUE' if keep_env_vars else 'VCPKG_PREFETCH_QUEUE'
+    open(queue_path, 'w').close()
+    # Portfiles stop at the first command which cannot run in download mode; the tool reports those.
+    output = subprocess.run([vcpkg, 'install', '--only-downloads', *install_args],
+                            stdout=subprocess.PIPE, stderr=subprocess.STDOUT, encoding='utf-8', env=env)
+    if output.returncode != 0:
+        print(f'prefetch: the download mode pass exited with {output.returncode}:\n{output.stdout.strip()}',
+              file=sys.stderr)
+
+
+def write_stamp(path, sha512):
+    """Writes the verified hash stamp of vcpkg_download_distfile, see VCPKG_VERIFY_CACHED_DOWNLOADS."""
+    stat = os.stat(path)
+    identity = f'size={stat.st_size}\nmtime={int(stat.st_mtime)}\n'
+    if os.name == 'posix':
+        identity += f'inode={stat.st_dev}:{stat.st_ino}\n'
+    staging_path = f'{path}.sha512-stamp.{os.getpid()}.tmp'
+    with open(staging_path, 'w', encoding='utf-8', newline='\n') as stamp_file:
+        stamp_file.write(f'{identity}sha512={sha512}\n')
+    os.replace(staging_path, f'{path}.sha512-stamp')
+
+
+def load_queue(queue_path):
+    entries = []
+    seen_paths = set()
+    with open(queue_path, 'r', encoding='utf-8') as queue_file:
+        for line in queue_file:
+            if not line.strip():
+                continue
+            entry = json.loads(line)
+            path = os.path.normpath(entry['path'])
+            if path in seen_paths or os.path.exists(path):
+                continue
+            seen_paths.add(path)
+            entry['path'] = path
+            entries.append(entry)
+    return entries
+
+
+class Prefetcher:
+    def __init__(self, entries, jobs, jobs_per_host):
+        self.entries = entries
+        self.jobs = jobs
+        self.jobs_per_host = jobs_per_host
+        self.host_slots = {}
+        self.lock = threading.Lock()
+        self.pending_markers = set()
+        self.finished = threading.Event()
+        self.failures = 0
+
+    def host_slot(self, url):
+        host = urllib.parse.urlsplit(url).netloc
+        with self.lock:
+            if host not in self.host_slots:
+                self.host_slots[host] = threading.BoundedSemaphore(self.jobs_per_host)
+            return self.host_slots[host]
+
+    def create_markers(self):
+        for entry in self.entries:
+            marker = f'{entry["path"]}.prefetch'
+            os.makedirs(os.path.dirname(marker), exist_ok=True)
+            with open(marker, 'w', encoding='utf-8') as marker_file:
+                marker_file.write(f'{os.getpid()}\n')
+            self.pending_markers.add(marker)
+
+    def remove_marker(self, marker):
+        with self.lock:
+            self.pending_markers.discard(marker)
+        try:
+            os.remove(marker)
+        except FileNotFoundError:
+            pass
+
+    def heartbeat(self):
+        while not self.finished.wait(HEARTBEAT_SECONDS):
+            with self.lock:
+                markers = list(self.pending_markers)
+            for marker in markers:
+                try:
+                    os.utime(marker)
+                except FileNotFoundError:
+                    pass
+
+    def download(self, url, headers, part_path):
+        request = urllib.request.Request(url, headers=headers)
+        sha512 = hashlib.sha512()
+        size = 0
+        with self.host_slot(url):
+            with urllib.request.urlopen(request, timeout=CONNECT_TIMEOUT_SECONDS) as response, \
+                    open(part_path, 'wb') as part_file:
+                while True:
+                    chunk = response.read(CHUNK_SIZE)
+                    if not chunk:
+                        break
+                    sha512.update(chunk)
+                    part_file.write(chunk)
+                    size += len(chunk)
+        return sha512.hexdigest(), size
+
+    def fetch(self, entry):
+        path = entry['path']
+        name = os.path.basename(path)
+        part_path = f'{path}.{os.getpid()}.part'
+        headers = {}
+        for header in entry.get('headers', []):
+            key, _, value = header.partition(':')
+            headers[key.strip()] = value.strip()
+        expected_sha512 = entry.get('sha512')
+        errors = []
+        start_time = time.time()
+        try:
+            for url in entry['urls']:
+                try:
+                    actual_sha512, size = self.download(url, headers, part_path)
+                except (OSError, ValueError, http.client.HTTPException) as e:
+                    errors.append(f'{url}: {e}')
+                    continue
+                if expected_sha512 and actual_sha512 != expected_sha512:
+                    errors.append(f'{url}: unexpected SHA512 {actual_sha512}')
+                    continue
+                os.replace(part_path, path)
+                if expected_sha512:
+                    write_stamp(path, actual_sha512)
+                print(f'prefetch: {name} ({size / (1 << 20):.1f} MiB in {time.time() - start_time:.1f} s)')
+                return
+            with self.lock:
+                self.failures += 1
+            print(f'prefetch: failed to download {name}, leaving it to vcpkg:\n  ' + '\n  '.join(errors),
+                  file=sys.stderr)
+        finally:
+            if os.path.exists(part_path):
+                os.remove(part_path)
+            self.remove_marker(f'{path}.prefetch')
+
+    def run(self):
+        heartbeat_thread = threading.Thread(target=self.heartbeat, daemon=True)
+        heartbeat_thread.start()
+        try:
+            with ThreadPoolExecutor(max_workers=self.jobs) as executor:
+                # Downloads start in the order of the install plan.
+                list(executor.map(self.fetch, self.entries))
+        finally:
+            self.finished.set()
+            for marker in list(self.pending_markers):
+                self.remove_marker(marker)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Prefetches the distfiles of the ports of a vcpkg install concurrently with the build.',
+        epilog='Example: python prefetchDistfiles.py --jobs 16 -- grpc abseil --triplet x64-linux')
+    parser.add_argument('--vcpkg', default=DEFAULT_VCPKG,
+                        help='The vcpkg executable.')
+    parser.add_argument('--jobs', type=int, default=8,
+                        help='The maximum number of concurrent downloads.')
+    parser.add_argument('--jobs-per-host', type=int, default=4,
+                        help='The maximum number of concurrent downloads from the same host.')
+    parser.add_argument('--queue',
+                        help='Prefetch the downloads recorded in this file instead of running the download mode pass.')
+    parser.add_argument('--no-build', action='store_true',
+                        help='Only prefetch the distfiles.')
+    parser.add_argument('install_args', nargs=argparse.REMAINDER,
+                        help='The arguments of vcpkg install, after --.')
+    args = parser.parse_args()
+    install_args = args.install_args[1:] if args.install_args[:1] == ['--'] else args.install_args
+    if args.jobs < 1 or args.jobs_per_host < 1:
+        parser.error('--jobs and --jobs-per-host must be at least 1')
+
+    # Asset caches and blocked origins are only known to vcpkg itself.
+    if 'X_VCPKG_ASSET_SOURCES' in os.environ:
+        print('prefetch: X_VCPKG_ASSET_SOURCES is set, downloads are left to vcpkg')
+        entries = []
+    elif args.queue:
+        entries = load_queue(args.queue)
+    else:
+        queue_fd, queue_path = tempfile.mkstemp(prefix='vcpkg-prefetch-', suffix='.jsonl')
+        os.close(queue_fd)
+        try:
+            start_time = time.time()
+            record_downloads(args.vcpkg, install_args, queue_path)
+            entries = load_queue(queue_path)
+            print(f'prefetch: found {len(entries)} downloads in {time.time() - start_time:.1f} s')
+        finally:
+            os.remove(queue_path)
+
+    prefetcher = Prefetcher(entries, args.jobs, args.jobs_per_host)
+    prefetcher.create_markers()
+    build = None
+    try:
+        if not args.no_build:
+            build = subprocess.Popen([args.vcpkg, 'install', *install_args])
+        prefetcher.run()
+    finally:
+        prefetcher.finished.set()
+        for marker in list(prefetcher.pending_markers):
+            prefetcher.remove_marker(marker)
+    if build is not None:
+        sys.exit(build.wait())
+    sys.exit(1 if prefetcher.failures else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -165,6 +165,10 @@ function(test_cmake_project)
         WORKING_DIRECTORY "${build_dir}"
         LOGNAME "${TARGET_TRIPLET}-${cmake_version}-${arg_NAME}-config"
     )
+    if("-DVCPKG_PROFILE_FIND_PACKAGE=ON" IN_LIST arg_OPTIONS AND cmake_version VERSION_GREATER_EQUAL "3.23"
+        AND NOT EXISTS "${build_dir}/vcpkg-find-package-profile.json")
+        message(SEND_ERROR "CMake ${cmake_version}: VCPKG_PROFILE_FIND_PACKAGE did not write vcpkg-find-package-profile.json.")
+    endif()
     vcpkg_execute_required_process(
         COMMAND
             "${arg_CMAKE_COMMAND}" --build . --target install
@@ -237,6 +241,7 @@ foreach(executable IN LISTS cmake_commands)
         CMAKE_COMMAND "${executable}"
         OPTIONS
             "-DCMAKE_BUILD_TYPE=Release"
+            "-DVCPKG_PROFILE_FIND_PACKAGE=ON"
     )
     if (NOT VCPKG_BUILD_TYPE)
         test_cmake_project(NAME "debug"
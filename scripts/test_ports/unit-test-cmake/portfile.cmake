@@ -18,9 +18,15 @@ endif()
 if("function-arguments" IN_LIST FEATURES)
     include("${CMAKE_CURRENT_LIST_DIR}/test-z_vcpkg_function_arguments.cmake")
 endif()
+if("cmake-config-fixup" IN_LIST FEATURES)
+    include("${CMAKE_CURRENT_LIST_DIR}/test-vcpkg_cmake_config_fixup.cmake")
+endif()
 if("merge-libs" IN_LIST FEATURES)
     include("${CMAKE_CURRENT_LIST_DIR}/test-z_vcpkg_cmake_config_fixup_merge.cmake")
 endif()
+if("cmake-install-script" IN_LIST FEATURES)
+    include("${CMAKE_CURRENT_LIST_DIR}/test-z_vcpkg_cmake_install_script.cmake")
+endif()
 if("backup-restore-env-vars" IN_LIST FEATURES)
     include("${CMAKE_CURRENT_LIST_DIR}/test-vcpkg_backup_restore_env_vars.cmake")
 endif()
@@ -37,5 +43,11 @@ endif()
 if("execute-required-process" IN_LIST FEATURES)
     include("${CMAKE_CURRENT_LIST_DIR}/test-vcpkg_execute_required_process.cmake")
 endif()
+if("download-distfile" IN_LIST FEATURES)
+    include("${CMAKE_CURRENT_LIST_DIR}/test-vcpkg_download_distfile.cmake")
+endif()
+if("manifest-install" IN_LIST FEATURES)
+    include("${CMAKE_CURRENT_LIST_DIR}/test-vcpkg_manifest_install.cmake")
+endif()
 
 unit_test_report_result()
@@ -36,3 +36,16 @@ change_and_backup()
 vcpkg_restore_env_variables(VARS A B)
 unit_test_check_variable_equal([[]] ENV{A} [[::a;::b]])
 unit_test_check_variable_equal([[]] ENV{B} [[]])
+
+# z_vcpkg_snapshot_env_variables(<out-var> VARS <list>)
+# Snapshots reproduce the values, including unset variables, when evaluated.
+set(ENV{A} [[::a;::b]])
+unset(ENV{B})
+z_vcpkg_snapshot_env_variables(snapshot VARS A B)
+unit_test_check_variable_equal([[]] ENV{A} [[::a;::b]])
+set(ENV{A} [[::a;::b;::c]])
+set(ENV{B} [[::1]])
+cmake_language(EVAL CODE "${snapshot}")
+unit_test_check_variable_equal([[]] ENV{A} [[::a;::b]])
+unit_test_check_variable_equal([[]] ENV{B} [[]])
+unit_test_ensure_fatal_error([[z_vcpkg_snapshot_env_variables(snapshot)]])
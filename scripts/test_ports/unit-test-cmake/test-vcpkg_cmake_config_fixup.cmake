@@ -0,0 +1,100 @@
+# Golden file test for vcpkg_cmake_config_fixup.
+# The files in vcpkg_cmake_config_fixup/input are installed to lib/cmake/unit-test-config-fixup of both
+# configurations, with @CURRENT_INSTALLED_DIR@ and @CURRENT_PACKAGES_DIR@ replaced. The result of the
+# fixup must match vcpkg_cmake_config_fixup/expected byte for byte, or expected-consolidated with
+# VCPKG_CMAKE_CONFIG_CONSOLIDATE.
+set(unit_test_config_fixup_data "${CMAKE_CURRENT_LIST_DIR}/vcpkg_cmake_config_fixup")
+
+function(unit_test_config_fixup_cleanup)
+    file(REMOVE_RECURSE
+        "${CURRENT_PACKAGES_DIR}/share/unit-test-config-fixup"
+        "${CURRENT_PACKAGES_DIR}/lib/cmake/unit-test-config-fixup"
+        "${CURRENT_PACKAGES_DIR}/debug/share/unit-test-config-fixup"
+        "${CURRENT_PACKAGES_DIR}/debug/lib/cmake/unit-test-config-fixup"
+    )
+    foreach(dir IN ITEMS lib/cmake lib debug/lib/cmake debug/lib debug/share share debug)
+        file(GLOB remaining "${CURRENT_PACKAGES_DIR}/${dir}/*")
+        if(IS_DIRECTORY "${CURRENT_PACKAGES_DIR}/${dir}" AND remaining STREQUAL "")
+            file(REMOVE_RECURSE "${CURRENT_PACKAGES_DIR}/${dir}")
+        endif()
+    endforeach()
+    # The fixup remembers the files it has seen, so that they are not fixed up twice.
+    unset(Z_VCPKG_CMAKE_CONFIG_ALREADY_FIXED_UP CACHE)
+endfunction()
+
+function(unit_test_config_fixup_prepare)
+    unit_test_config_fixup_cleanup()
+    foreach(config IN ITEMS release debug)
+        set(prefix "${CURRENT_PACKAGES_DIR}")
+        if(config STREQUAL "debug")
+            set(prefix "${CURRENT_PACKAGES_DIR}/debug")
+        endif()
+        file(GLOB_RECURSE inputs RELATIVE "${unit_test_config_fixup_data}/input/${config}" "${unit_test_config_fixup_data}/input/${config}/*.in")
+        foreach(input IN LISTS inputs)
+            string(REGEX REPLACE "\\.in\$" "" output "${input}")
+            configure_file("${unit_test_config_fixup_data}/input/${config}/${input}" "${prefix}/lib/cmake/unit-test-config-fixup/${output}" @ONLY)
+        endforeach()
+    endforeach()
+endfunction()
+
+function(unit_test_config_fixup_check description expected)
+    set(actual_dir "${CURRENT_PACKAGES_DIR}/share/unit-test-config-fixup")
+    set(expected_dir "${unit_test_config_fixup_data}/${expected}")
+    file(GLOB_RECURSE actual_files RELATIVE "${actual_dir}" "${actual_dir}/*")
+    file(GLOB_RECURSE expected_files RELATIVE "${expected_dir}" "${expected_dir}/*")
+    list(SORT actual_files)
+    list(SORT expected_files)
+    if(NOT actual_files STREQUAL expected_files)
+        message(SEND_ERROR "vcpkg_cmake_config_fixup() (${description}) resulted in the wrong files;
+    expected: ${expected_files}
+    actual  : ${actual_files}")
+        set_has_error()
+        return()
+    endif()
+    foreach(file IN LISTS expected_files)
+        file(READ "${actual_dir}/${file}" actual)
+        file(READ "${expected_dir}/${file}" expected)
+        if(NOT actual STREQUAL expected)
+            message(SEND_ERROR "vcpkg_cmake_config_fixup() (${description}) resulted in a wrong ${file}")
+            set_has_error()
+        endif()
+    endforeach()
+    foreach(dir IN ITEMS debug/share/unit-test-config-fixup debug/lib/cmake/unit-test-config-fixup lib/cmake/unit-test-config-fixup)
+        if(EXISTS "${CURRENT_PACKAGES_DIR}/${dir}")
+            message(SEND_ERROR "vcpkg_cmake_config_fixup() (${description}) did not remove ${dir}")
+            set_has_error()
+        endif()
+    endforeach()
+endfunction()
+
+function(unit_test_config_fixup_run description min_parallel_files consolidate)
+    # The expected files use this suffix on all platforms.
+    set(VCPKG_TARGET_EXECUTABLE_SUFFIX ".exe")
+    set(Z_VCPKG_CMAKE_CONFIG_FIXUP_MIN_PARALLEL_FILES "${min_parallel_files}")
+    set(VCPKG_CMAKE_CONFIG_CONSOLIDATE "${consolidate}")
+    set(expected "expected")
+    if(consolidate)
+        set(expected "expected-consolidated")
+    endif()
+    unit_test_config_fixup_prepare()
+    unit_test_ensure_success([[
+        vcpkg_cmake_config_fixup(
+            PACKAGE_NAME unit-test-config-fixup
+            CONFIG_PATH lib/cmake/unit-test-config-fixup
+            TOOLS_PATH tools/utcf
+        )
+    ]])
+    if(consolidate)
+        # Consolidated files are left as they are.
+        unit_test_ensure_success([[ z_vcpkg_cmake_config_consolidate("${CURRENT_PACKAGES_DIR}/share/unit-test-config-fixup") ]])
+    endif()
+    unit_test_config_fixup_check("${description}" "${expected}")
+    unit_test_config_fixup_cleanup()
+endfunction()
+
+# The expected files are those of a build with both configurations.
+if(NOT DEFINED VCPKG_BUILD_TYPE)
+    unit_test_config_fixup_run("files processed in sequence" 1000 OFF)
+    unit_test_config_fixup_run("files processed in parallel" 1 OFF)
+    unit_test_config_fixup_run("consolidated target files" 1000 ON)
+endif()
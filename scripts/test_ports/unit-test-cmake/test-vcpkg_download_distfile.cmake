@@ -0,0 +1,188 @@
+# vcpkg_download_distfile, VCPKG_PREFETCH_QUEUE, VCPKG_VERIFY_CACHED_DOWNLOADS, prefetchDistfiles.py
+
+block(SCOPE_FOR VARIABLES)
+
+set(DOWNLOADS "${CURRENT_BUILDTREES_DIR}/vcpkg_download_distfile-downloads")
+set(queue "${CURRENT_BUILDTREES_DIR}/vcpkg_download_distfile-queue.jsonl")
+file(REMOVE_RECURSE "${DOWNLOADS}")
+file(REMOVE "${queue}")
+file(WRITE "${DOWNLOADS}/cached.txt" "cached")
+file(SHA512 "${DOWNLOADS}/cached.txt" cached_sha512)
+string(REPEAT 1 128 queued_sha512)
+
+set(VCPKG_DOWNLOAD_MODE 1)
+set(ENV{VCPKG_PREFETCH_QUEUE} "${queue}")
+unit_test_check_variable_equal([[
+    vcpkg_download_distfile(path
+        URLS "http://127.0.0.1:1/cached.txt"
+        FILENAME cached.txt
+        SHA512 "${cached_sha512}"
+    )]]
+    path "${DOWNLOADS}/cached.txt"
+)
+unit_test_check_variable_equal([[
+    vcpkg_download_distfile(path
+        URLS "http://127.0.0.1:1/primary/queued.tar.gz" "http://127.0.0.1:1/mirror/queued.tar.gz"
+        FILENAME "sub/queued.tar.gz"
+        SHA512 "${queued_sha512}"
+        HEADERS "Accept: application/octet-stream"
+    )]]
+    path "${DOWNLOADS}/sub/queued.tar.gz"
+)
+unit_test_check_variable_equal([[
+    vcpkg_download_distfile(path
+        URLS "http://127.0.0.1:1/unchecked.zip"
+        FILENAME unchecked.zip
+        SKIP_SHA512
+    )]]
+    path "${DOWNLOADS}/unchecked.zip"
+)
+unset(ENV{VCPKG_PREFETCH_QUEUE})
+set(VCPKG_DOWNLOAD_MODE "")
+
+# Cached files are not queued, and queued files are not downloaded.
+unit_test_check_variable_equal([[
+    file(STRINGS "${queue}" entries)
+    list(LENGTH entries count)
+    ]] count 2
+)
+unit_test_check_variable_equal([[
+    set(exists OFF)
+    if(EXISTS "${DOWNLOADS}/sub/queued.tar.gz")
+        set(exists ON)
+    endif()
+    ]] exists OFF
+)
+
+file(STRINGS "${queue}" entries)
+list(GET entries 0 entry)
+unit_test_check_variable_equal([[ string(JSON value GET "${entry}" port) ]] value "${PORT}")
+unit_test_check_variable_equal([[ string(JSON value GET "${entry}" path) ]] value "${DOWNLOADS}/sub/queued.tar.gz")
+unit_test_check_variable_equal([[ string(JSON value GET "${entry}" sha512) ]] value "${queued_sha512}")
+unit_test_check_variable_equal([[ string(JSON value GET "${entry}" urls 1) ]] value "http://127.0.0.1:1/mirror/queued.tar.gz")
+unit_test_check_variable_equal([[ string(JSON value GET "${entry}" headers 0) ]] value "Accept: application/octet-stream")
+list(GET entries 1 entry)
+unit_test_check_variable_equal([[ string(JSON value TYPE "${entry}" sha512) ]] value "NULL")
+
+# Queued archives are not extracted or patched, so the downloads after an extraction are queued too.
+set(queue "${CURRENT_BUILDTREES_DIR}/vcpkg_download_distfile-sources.jsonl")
+file(REMOVE "${queue}")
+set(VCPKG_DOWNLOAD_MODE 1)
+set(ENV{VCPKG_PREFETCH_QUEUE} "${queue}")
+foreach(PORT IN ITEMS first-port second-port)
+    vcpkg_download_distfile(archive
+        URLS "http://127.0.0.1:1/${PORT}-main.tar.gz"
+        FILENAME "${PORT}-main.tar.gz"
+        SHA512 "${queued_sha512}"
+    )
+    unit_test_check_variable_equal([[
+        vcpkg_extract_source_archive(source_path ARCHIVE "${archive}" PATCHES missing.patch)
+        file(GLOB source_files "${source_path}/*")
+        ]] source_files ""
+    )
+    unit_test_check_variable_equal([[
+        vcpkg_download_distfile(path
+            URLS "http://127.0.0.1:1/${PORT}-submodule.tar.gz"
+            FILENAME "${PORT}-submodule.tar.gz"
+            SHA512 "${queued_sha512}"
+        )]]
+        path "${DOWNLOADS}/${PORT}-submodule.tar.gz"
+    )
+endforeach()
+unset(ENV{VCPKG_PREFETCH_QUEUE})
+set(VCPKG_DOWNLOAD_MODE "")
+
+unit_test_check_variable_equal([[
+    file(STRINGS "${queue}" entries)
+    set(queued "")
+    foreach(entry IN LISTS entries)
+        string(JSON port GET "${entry}" port)
+        string(JSON path GET "${entry}" path)
+        cmake_path(GET path FILENAME filename)
+        list(APPEND queued "${port}:${filename}")
+    endforeach()
+    ]] queued "first-port:first-port-main.tar.gz;first-port:first-port-submodule.tar.gz;second-port:second-port-main.tar.gz;second-port:second-port-submodule.tar.gz"
+)
+
+
+# Verified hash stamps
+
+unit_test_check_variable_equal([[ file(STRINGS "${DOWNLOADS}/cached.txt.sha512-stamp" stamp REGEX "^sha512=") ]] stamp "sha512=${cached_sha512}")
+
+# A valid stamp is trusted, so a forged hash shows that the file is not read.
+string(REPEAT 2 128 forged_sha512)
+file(READ "${DOWNLOADS}/cached.txt.sha512-stamp" stamp)
+string(REPLACE "${cached_sha512}" "${forged_sha512}" forged_stamp "${stamp}")
+file(WRITE "${DOWNLOADS}/cached.txt.sha512-stamp" "${forged_stamp}")
+unit_test_check_variable_equal([[ z_vcpkg_download_distfile_sha512(hash "${DOWNLOADS}/cached.txt") ]] hash "${forged_sha512}")
+set(VCPKG_VERIFY_CACHED_DOWNLOADS ON)
+unit_test_check_variable_equal([[ z_vcpkg_download_distfile_sha512(hash "${DOWNLOADS}/cached.txt") ]] hash "${cached_sha512}")
+set(VCPKG_VERIFY_CACHED_DOWNLOADS OFF)
+
+# Changes of the file invalidate the stamp.
+file(WRITE "${DOWNLOADS}/cached.txt.sha512-stamp" "${forged_stamp}")
+file(WRITE "${DOWNLOADS}/cached.txt" "changed")
+file(SHA512 "${DOWNLOADS}/cached.txt" changed_sha512)
+unit_test_check_variable_equal([[ z_vcpkg_download_distfile_sha512(hash "${DOWNLOADS}/cached.txt") ]] hash "${changed_sha512}")
+unit_test_check_variable_equal([[ file(STRINGS "${DOWNLOADS}/cached.txt.sha512-stamp" stamp REGEX "^sha512=") ]] stamp "sha512=${changed_sha512}")
+
+
+# prefetchDistfiles.py against a local HTTP server, see vcpkg_download_distfile/serve-and-prefetch.py
+
+set(fixtures "${CURRENT_BUILDTREES_DIR}/vcpkg_download_distfile-fixtures")
+set(DOWNLOADS "${CURRENT_BUILDTREES_DIR}/vcpkg_download_distfile-prefetched")
+set(queue_template "${CURRENT_BUILDTREES_DIR}/vcpkg_download_distfile-queue.in")
+file(REMOVE_RECURSE "${fixtures}" "${DOWNLOADS}")
+file(REMOVE "${queue_template}" "${queue}")
+file(WRITE "${fixtures}/good.tar.gz" "good")
+file(WRITE "${fixtures}/primary/mirrored.tar.gz" "corrupt")
+file(WRITE "${fixtures}/mirror/mirrored.tar.gz" "mirrored")
+file(SHA512 "${fixtures}/good.tar.gz" good_sha512)
+file(SHA512 "${fixtures}/mirror/mirrored.tar.gz" mirrored_sha512)
+
+set(VCPKG_DOWNLOAD_MODE 1)
+set(ENV{VCPKG_PREFETCH_QUEUE} "${queue_template}")
+vcpkg_download_distfile(path URLS "http://@SERVER@/good.tar.gz" FILENAME good.tar.gz SHA512 "${good_sha512}")
+vcpkg_download_distfile(path
+    URLS "http://@SERVER@/primary/mirrored.tar.gz" "http://@SERVER@/mirror/mirrored.tar.gz"
+    FILENAME mirrored.tar.gz
+    SHA512 "${mirrored_sha512}"
+)
+vcpkg_download_distfile(path URLS "http://@SERVER@/missing.tar.gz" FILENAME missing.tar.gz SHA512 "${good_sha512}")
+unset(ENV{VCPKG_PREFETCH_QUEUE})
+set(VCPKG_DOWNLOAD_MODE "")
+
+vcpkg_find_acquire_program(PYTHON3)
+# The missing file is a failed prefetch.
+unit_test_check_variable_equal([[
+    execute_process(
+        COMMAND "${PYTHON3}" "${CMAKE_CURRENT_LIST_DIR}/vcpkg_download_distfile/serve-and-prefetch.py"
+            "${SCRIPTS}/prefetchDistfiles.py" "${fixtures}" "${queue_template}" "${queue}"
+        RESULT_VARIABLE result
+        OUTPUT_QUIET
+        ERROR_QUIET
+    )]]
+    result 1
+)
+unit_test_check_variable_equal([[ file(READ "${DOWNLOADS}/good.tar.gz" contents) ]] contents "good")
+# A hash mismatch of the primary URL falls over to the mirror.
+unit_test_check_variable_equal([[ file(READ "${DOWNLOADS}/mirrored.tar.gz" contents) ]] contents "mirrored")
+unit_test_check_variable_equal([[
+    set(exists OFF)
+    if(EXISTS "${DOWNLOADS}/missing.tar.gz")
+        set(exists ON)
+    endif()
+    ]] exists OFF
+)
+unit_test_check_variable_equal([[ file(GLOB leftovers "${DOWNLOADS}/*.prefetch" "${DOWNLOADS}/*.part") ]] leftovers "")
+
+# The stamps of the prefetched files are trusted by vcpkg_download_distfile.
+unit_test_check_variable_equal([[
+    z_vcpkg_download_distfile_file_identity(identity "${DOWNLOADS}/good.tar.gz")
+    file(READ "${DOWNLOADS}/good.tar.gz.sha512-stamp" stamp)
+    string(REPLACE "${identity}" "" stamp "${stamp}")
+    ]] stamp "sha512=${good_sha512}\n"
+)
+unit_test_check_variable_equal([[ file(STRINGS "${DOWNLOADS}/mirrored.tar.gz.sha512-stamp" stamp REGEX "^sha512=") ]] stamp "sha512=${mirrored_sha512}")
+
+endblock()
@@ -0,0 +1,94 @@
+# VCPKG_MANIFEST_INSTALL_SKIP_UNCHANGED of scripts/buildsystems/vcpkg.cmake
+# A project is configured against a copy of the toolchain in a fake vcpkg root, whose vcpkg executable
+# only counts the installs. The fake executable is a shell script, so this test does not run on Windows.
+
+if(NOT CMAKE_HOST_WIN32)
+block(SCOPE_FOR VARIABLES)
+
+set(test_dir "${CURRENT_BUILDTREES_DIR}/vcpkg_manifest_install")
+set(vcpkg_root "${test_dir}/vcpkg")
+set(project_dir "${test_dir}/project")
+set(build_dir "${test_dir}/build")
+set(install_log "${test_dir}/installs.txt")
+
+# Sets installs to the number of vcpkg install runs so far.
+function(unit_test_configure_manifest_project)
+    execute_process(
+        COMMAND "${CMAKE_COMMAND}" -S "${project_dir}" -B "${build_dir}"
+            "-DCMAKE_TOOLCHAIN_FILE=${vcpkg_root}/scripts/buildsystems/vcpkg.cmake"
+            -DVCPKG_TARGET_TRIPLET=x64-linux
+        OUTPUT_VARIABLE output
+        ERROR_VARIABLE output
+        RESULT_VARIABLE result
+    )
+    if(NOT result STREQUAL "0")
+        message(SEND_ERROR "Configuring the manifest project failed with ${result}:\n${output}")
+        set_has_error()
+    endif()
+    set(installs 0)
+    if(EXISTS "${install_log}")
+        file(STRINGS "${install_log}" install_lines)
+        list(LENGTH install_lines installs)
+    endif()
+    set(installs "${installs}" PARENT_SCOPE)
+endfunction()
+
+function(unit_test_git)
+    execute_process(
+        COMMAND git -c user.name=vcpkg -c user.email=vcpkg@example.com ${ARGN}
+        WORKING_DIRECTORY "${vcpkg_root}"
+        OUTPUT_QUIET
+        RESULT_VARIABLE result
+    )
+    if(NOT result STREQUAL "0")
+        message(SEND_ERROR "git ${ARGN} failed with ${result}")
+        set_has_error()
+    endif()
+endfunction()
+
+foreach(registry IN ITEMS "directory" "git")
+    file(REMOVE_RECURSE "${test_dir}")
+    file(WRITE "${vcpkg_root}/.vcpkg-root" "")
+    file(COPY "${SCRIPTS}/buildsystems/vcpkg.cmake" DESTINATION "${vcpkg_root}/scripts/buildsystems")
+    file(WRITE "${vcpkg_root}/versions/baseline.json" "{}\n")
+    file(WRITE "${vcpkg_root}/ports/zlib/portfile.cmake" "# original\n")
+    file(WRITE "${vcpkg_root}/vcpkg" "#!/bin/sh\necho install >> \"${install_log}\"\n")
+    file(CHMOD "${vcpkg_root}/vcpkg" PERMISSIONS OWNER_READ OWNER_WRITE OWNER_EXECUTE)
+    file(WRITE "${project_dir}/CMakeLists.txt" "cmake_minimum_required(VERSION 3.21)\nproject(manifest LANGUAGES NONE)\n")
+    file(WRITE "${project_dir}/vcpkg.json" "{\"dependencies\": [\"zlib\"]}\n")
+    if(registry STREQUAL "git")
+        unit_test_git(init -q)
+        unit_test_git(add -A)
+        unit_test_git(commit -q -m initial)
+    endif()
+
+    unit_test_check_variable_equal([[ unit_test_configure_manifest_project() ]] installs 1)
+    unit_test_check_variable_equal([[ unit_test_configure_manifest_project() ]] installs 1)
+
+    # An edit of a builtin port without a version change.
+    file(WRITE "${vcpkg_root}/ports/zlib/portfile.cmake" "# edited\n")
+    execute_process(COMMAND touch -t 203001010000 "${vcpkg_root}/ports/zlib/portfile.cmake")
+    unit_test_check_variable_equal([[ unit_test_configure_manifest_project() ]] installs 2)
+    unit_test_check_variable_equal([[ unit_test_configure_manifest_project() ]] installs 2)
+
+    # Another edit of the same file, which keeps its git status.
+    file(WRITE "${vcpkg_root}/ports/zlib/portfile.cmake" "# edited again\n")
+    execute_process(COMMAND touch -t 203101010000 "${vcpkg_root}/ports/zlib/portfile.cmake")
+    unit_test_check_variable_equal([[ unit_test_configure_manifest_project() ]] installs 3)
+
+    # A new file of a builtin port.
+    file(WRITE "${vcpkg_root}/ports/zlib/fix.patch" "")
+    unit_test_check_variable_equal([[ unit_test_configure_manifest_project() ]] installs 4)
+    unit_test_check_variable_equal([[ unit_test_configure_manifest_project() ]] installs 4)
+
+    if(registry STREQUAL "git")
+        # Committing the edits changes HEAD.
+        unit_test_git(add -A)
+        unit_test_git(commit -q -m edit)
+        unit_test_check_variable_equal([[ unit_test_configure_manifest_project() ]] installs 5)
+        unit_test_check_variable_equal([[ unit_test_configure_manifest_project() ]] installs 5)
+    endif()
+endforeach()
+
+endblock()
+endif()
@@ -118,4 +118,114 @@ unit_test_check_variable_equal([[
 ]] out [[$ORIGIN:$ORIGIN/../foo/bar]])
 
 
+endblock()
+
+# z_vcpkg_fixup_rpath_in_dir() timing over a synthetic tree of 5000 files
+
+block(SCOPE_FOR VARIABLES)
+
+set(timing_root "${CURRENT_BUILDTREES_DIR}/fixup-rpath-timing")
+file(REMOVE_RECURSE "${timing_root}")
+set(CURRENT_PACKAGES_DIR "${timing_root}/P")
+set(CURRENT_INSTALLED_DIR "${timing_root}/I")
+set(X_VCPKG_RPATH_KEEP_SYSTEM_PATHS 0)
+
+# Stand-in for patchelf: the synthetic ELF files carry their RPATH in the second line.
+set(PATCHELF "${timing_root}/patchelf")
+file(WRITE "${PATCHELF}" [[#!/bin/sh
+mode="$1"
+shift
+if [ "$mode" = "--print-rpath" ]; then
+    for file in "$@"; do
+        { read -r magic; read -r rpath; } < "$file"
+        printf '%s\n' "$rpath"
+    done
+elif [ "$mode" = "--set-rpath" ]; then
+    rpath="$1"
+    shift
+    for file in "$@"; do
+        printf '\177ELF\n%s\n' "$rpath" > "$file"
+    done
+else
+    exit 1
+fi
+]])
+file(CHMOD "${PATCHELF}" PERMISSIONS OWNER_READ OWNER_WRITE OWNER_EXECUTE)
+
+string(ASCII 127 elf_magic_prefix)
+set(elf_magic "${elf_magic_prefix}ELF")
+set(elf_dirs "lib" "debug/lib" "tools/port" "tools/port/debug/bin" "plugins/group")
+set(org_rpaths "" "${CURRENT_PACKAGES_DIR}/lib" "${CURRENT_INSTALLED_DIR}/lib:/usr/lib" "${CURRENT_INSTALLED_DIR}/foo/lib/pkgconfig/../../bar")
+
+set(file_count 5000)
+math(EXPR last_file "${file_count} - 1")
+foreach(i RANGE "${last_file}")
+    math(EXPR dir_index "${i} % 5")
+    math(EXPR rpath_index "(${i} / 5) % 4")
+    list(GET elf_dirs "${dir_index}" elf_dir)
+    list(GET org_rpaths "${rpath_index}" org_rpath)
+    math(EXPR kind "${i} % 10")
+    if(kind EQUAL "0")
+        # Not an ELF file, must be left untouched.
+        file(WRITE "${CURRENT_PACKAGES_DIR}/${elf_dir}/data${i}" "data\n${org_rpath}\n")
+    else()
+        file(WRITE "${CURRENT_PACKAGES_DIR}/${elf_dir}/libfile${i}.so" "${elf_magic}\n${org_rpath}\n")
+    endif()
+endforeach()
+# Headers are never scanned.
+file(WRITE "${CURRENT_PACKAGES_DIR}/include/header" "${elf_magic}\n/nowhere\n")
+
+function(z_test_verify_fixed_rpaths out_var)
+    set(mismatches "")
+    file(GLOB_RECURSE all_files LIST_DIRECTORIES FALSE "${CURRENT_PACKAGES_DIR}/*")
+    foreach(file IN LISTS all_files)
+        file(STRINGS "${file}" lines)
+        list(GET lines 0 magic)
+        list(LENGTH lines line_count)
+        set(actual "")
+        if(line_count GREATER "1")
+            list(GET lines 1 actual)
+        endif()
+
+        get_filename_component(file_name "${file}" NAME)
+        get_filename_component(file_dir "${file}" DIRECTORY)
+        if(file_name MATCHES "^libfile([0-9]+)\\.so$")
+            math(EXPR rpath_index "(${CMAKE_MATCH_1} / 5) % 4")
+            list(GET org_rpaths "${rpath_index}" org_rpath)
+            z_vcpkg_calculate_corrected_rpath(ELF_FILE_DIR "${file_dir}" ORG_RPATH "${org_rpath}" OUT_NEW_RPATH_VAR expected)
+        elseif(file_name MATCHES "^data([0-9]+)$")
+            math(EXPR rpath_index "(${CMAKE_MATCH_1} / 5) % 4")
+            list(GET org_rpaths "${rpath_index}" expected)
+        else()
+            set(expected "/nowhere")
+        endif()
+
+        if(NOT "${actual}" STREQUAL "${expected}")
+            list(APPEND mismatches "${file}")
+        endif()
+    endforeach()
+    set("${out_var}" "${mismatches}" PARENT_SCOPE)
+endfunction()
+
+string(TIMESTAMP start_time "%s" UTC)
+unit_test_ensure_success([[
+    z_vcpkg_fixup_rpath_in_dir()
+]])
+string(TIMESTAMP end_time "%s" UTC)
+math(EXPR elapsed "${end_time} - ${start_time}")
+message(STATUS "z_vcpkg_fixup_rpath_in_dir() processed ${file_count} files in ${elapsed} s")
+
+unit_test_check_variable_equal([[
+    z_test_verify_fixed_rpaths(mismatches)
+]] mismatches "")
+
+# Generous budget to stay reliable on loaded CI machines.
+set(time_budget 60)
+if(elapsed GREATER time_budget)
+    message(SEND_ERROR "z_vcpkg_fixup_rpath_in_dir() took ${elapsed} s for ${file_count} files; budget: ${time_budget} s")
+    set_has_error()
+endif()
+
+file(REMOVE_RECURSE "${timing_root}")
+
 endblock()
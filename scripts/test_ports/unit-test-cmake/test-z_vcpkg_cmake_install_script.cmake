@@ -0,0 +1,133 @@
+# z_vcpkg_cmake_install_script.cmake, the file(INSTALL) override of vcpkg_cmake_install.
+# The script replaces file(), so each install script runs in a separate process. Every case is
+# installed with the plain file(INSTALL) as a reference, and with Z_VCPKG_INSTALL_LINK_MODE=reflink
+# both where cloning works and where it falls back to file(INSTALL). All must produce the same files
+# and the same CMAKE_INSTALL_MANIFEST_FILES. Cloning is simulated by a cp on the PATH which copies,
+# and its failure by a cp which fails, so this test does not run on Windows.
+
+if(NOT CMAKE_HOST_WIN32)
+block(SCOPE_FOR VARIABLES)
+
+set(install_test_dir "${CURRENT_BUILDTREES_DIR}/z_vcpkg_cmake_install_script")
+set(install_source "${install_test_dir}/src")
+set(install_prefix "${install_test_dir}/prefix")
+file(REMOVE_RECURSE "${install_test_dir}")
+file(WRITE "${install_source}/a.h" "a")
+file(WRITE "${install_source}/b.h" "b")
+file(WRITE "${install_source}/dir/x.txt" "x")
+file(WRITE "${install_source}/dir/sub/y.txt" "y")
+file(WRITE "${install_source}/linked/real.txt" "real")
+
+find_program(real_cp NAMES cp REQUIRED)
+file(WRITE "${install_test_dir}/clone/cp" "#!/bin/sh
+for arg do
+    shift
+    case \"$arg\" in
+        --reflink=*|-c) ;;
+        *) set -- \"$@\" \"$arg\" ;;
+    esac
+done
+exec \"${real_cp}\" \"$@\"
+")
+file(WRITE "${install_test_dir}/unsupported/cp" "#!/bin/sh\nexit 1\n")
+file(CHMOD "${install_test_dir}/clone/cp" "${install_test_dir}/unsupported/cp"
+    PERMISSIONS OWNER_READ OWNER_WRITE OWNER_EXECUTE)
+
+# Runs the install script with the cp of cp_dir. Sets method to reflink or copy, and installed and
+# manifest to the installed files relative to the prefix.
+function(unit_test_run_install_script link_mode cp_dir code)
+    file(REMOVE_RECURSE "${install_prefix}")
+    file(REMOVE "${install_test_dir}/manifest.txt")
+    string(CONFIGURE "${code}" code)
+    file(WRITE "${install_test_dir}/cmake_install.cmake"
+        "${code}\nfile(WRITE [[${install_test_dir}/manifest.txt]] \"\${CMAKE_INSTALL_MANIFEST_FILES}\")\n")
+    execute_process(
+        COMMAND "${CMAKE_COMMAND}" -E env "PATH=${install_test_dir}/${cp_dir}:$ENV{PATH}"
+            "${CMAKE_COMMAND}"
+            -DCMAKE_INSTALL_CONFIG_NAME=Release
+            "-DZ_VCPKG_INSTALL_SCRIPT=${install_test_dir}/cmake_install.cmake"
+            "-DZ_VCPKG_INSTALL_LINK_MODE=${link_mode}"
+            ${ARGN}
+            -P "${Z_VCPKG_CMAKE_INSTALL_SCRIPT}"
+        OUTPUT_VARIABLE output
+        ERROR_VARIABLE output
+        RESULT_VARIABLE result
+    )
+    if(NOT result STREQUAL "0")
+        message(SEND_ERROR "The install script failed with ${result}:\n${output}")
+        set_has_error()
+    endif()
+
+    set(method copy)
+    if(output MATCHES "Installing \\(reflink\\): ")
+        set(method reflink)
+    endif()
+    file(GLOB_RECURSE installed RELATIVE "${install_prefix}" "${install_prefix}/*")
+    list(SORT installed)
+    file(READ "${install_test_dir}/manifest.txt" manifest)
+    string(REPLACE "${install_prefix}/" "" manifest "${manifest}")
+    list(SORT manifest)
+    set(method "${method}" PARENT_SCOPE)
+    set(installed "${installed}" PARENT_SCOPE)
+    set(manifest "${manifest}" PARENT_SCOPE)
+    set(output "${output}" PARENT_SCOPE)
+endfunction()
+
+function(unit_test_install_script_case description expected_method expected_installed code)
+    unit_test_run_install_script("" clone "${code}" ${ARGN})
+    set(reference_manifest "${manifest}")
+    foreach(cp_dir IN ITEMS clone unsupported)
+        unit_test_run_install_script(reflink "${cp_dir}" "${code}" ${ARGN})
+        if(cp_dir STREQUAL "unsupported")
+            set(expected_method copy)
+        endif()
+        foreach(var IN ITEMS method installed manifest)
+            set(expected "${expected_${var}}")
+            if(var STREQUAL "manifest")
+                set(expected "${reference_manifest}")
+            endif()
+            if(NOT "${${var}}" STREQUAL "${expected}")
+                message(SEND_ERROR "z_vcpkg_cmake_install_script (${description}, ${cp_dir} cp) resulted in the wrong ${var};
+    expected: \"${expected}\"
+    actual  : \"${${var}}\"")
+                set_has_error()
+            endif()
+        endforeach()
+    endforeach()
+    set(output "${output}" PARENT_SCOPE)
+endfunction()
+
+unit_test_install_script_case("files" reflink "include/a.h;include/b.h" [[
+    file(INSTALL DESTINATION "${install_prefix}/include" TYPE FILE FILES "${install_source}/a.h" "${install_source}/b.h")
+]])
+unit_test_install_script_case("directory" reflink "share/dir/sub/y.txt;share/dir/x.txt" [[
+    file(INSTALL DESTINATION "${install_prefix}/share" TYPE DIRECTORY FILES "${install_source}/dir")
+]])
+unit_test_install_script_case("directory with a trailing slash" reflink "share/sub/y.txt;share/x.txt" [[
+    file(INSTALL DESTINATION "${install_prefix}/share" TYPE DIRECTORY FILES "${install_source}/dir/")
+]])
+unit_test_install_script_case("permissions" copy "bin/a.h" [[
+    file(INSTALL DESTINATION "${install_prefix}/bin" TYPE FILE PERMISSIONS OWNER_READ OWNER_WRITE OWNER_EXECUTE FILES "${install_source}/a.h")
+]])
+unit_test_install_script_case("rename" copy "include/c.h" [[
+    file(INSTALL DESTINATION "${install_prefix}/include" TYPE FILE RENAME "c.h" FILES "${install_source}/a.h")
+]])
+file(CREATE_LINK "real.txt" "${install_source}/linked/alias.txt" SYMBOLIC)
+unit_test_install_script_case("symlink" copy "share/linked/alias.txt;share/linked/real.txt" [[
+    file(INSTALL DESTINATION "${install_prefix}/share" TYPE DIRECTORY FILES "${install_source}/linked")
+]])
+
+unit_test_install_script_case("skipped directory" reflink "include/a.h" [[
+    file(INSTALL DESTINATION "${install_prefix}/include" TYPE FILE FILES "${install_source}/a.h")
+    file(INSTALL DESTINATION "${install_prefix}/share/doc" TYPE FILE FILES "${install_source}/b.h")
+]] "-DZ_VCPKG_INSTALL_SKIP_DIR=${install_prefix}/share")
+unit_test_check_variable_equal([[
+    set(skipped OFF)
+    if(output MATCHES "Skipping: [^\n]*/share/doc")
+        set(skipped ON)
+    endif()
+    ]] skipped ON
+)
+
+endblock()
+endif()
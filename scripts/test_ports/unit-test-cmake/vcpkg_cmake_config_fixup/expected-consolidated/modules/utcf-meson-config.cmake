@@ -0,0 +1,2 @@
+get_filename_component(PACKAGE_PREFIX_DIR "${CMAKE_CURRENT_LIST_DIR}/../../" ABSOLUTE)
+set(UTCF_MESON_LIBRARY "${PACKAGE_PREFIX_DIR}/lib/libutcf-meson.a")
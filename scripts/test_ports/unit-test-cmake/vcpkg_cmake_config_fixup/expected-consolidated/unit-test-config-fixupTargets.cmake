@@ -0,0 +1,119 @@
+get_filename_component(VCPKG_IMPORT_PREFIX "${CMAKE_CURRENT_LIST_DIR}/../../" ABSOLUTE)
+# Generated CMake target import file.
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Compute the installation prefix relative to this file.
+get_filename_component(_IMPORT_PREFIX "${CMAKE_CURRENT_LIST_FILE}" PATH)
+get_filename_component(_IMPORT_PREFIX "${_IMPORT_PREFIX}" PATH)
+get_filename_component(_IMPORT_PREFIX "${_IMPORT_PREFIX}" PATH)
+if(_IMPORT_PREFIX STREQUAL "/")
+  set(_IMPORT_PREFIX "")
+endif()
+
+# Create imported target utcf::core
+add_library(utcf::core STATIC IMPORTED)
+
+set_target_properties(utcf::core PROPERTIES
+  INTERFACE_INCLUDE_DIRECTORIES "${_IMPORT_PREFIX}/include"
+  INTERFACE_LINK_LIBRARIES "ZLIB::ZLIB;\$<\$<NOT:\$<CONFIG:DEBUG>>:${VCPKG_IMPORT_PREFIX}/lib/libextra.a>;\$<\$<CONFIG:DEBUG>:${VCPKG_IMPORT_PREFIX}/debug/lib/libextra_d.a>;\$<LINK_ONLY:m>"
+)
+
+# Create imported target utcf::tool
+add_executable(utcf::tool IMPORTED)
+
+# Create imported target utcf::plugin
+add_library(utcf::plugin SHARED IMPORTED)
+
+set_target_properties(utcf::plugin PROPERTIES
+  INTERFACE_LINK_LIBRARIES "utcf::core;\$<\$<NOT:\$<CONFIG:DEBUG>>:${VCPKG_IMPORT_PREFIX}/lib/libopt.a>;\$<\$<CONFIG:DEBUG>:${VCPKG_IMPORT_PREFIX}/debug/lib/libopt_d.a>"
+)
+
+# Load information for each installed configuration.
+# Inlined from unit-test-config-fixupTargets-debug.cmake
+#----------------------------------------------------------------
+# Generated CMake target import file for configuration "Debug".
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Import target "utcf::core" for configuration "Debug"
+set_property(TARGET utcf::core APPEND PROPERTY IMPORTED_CONFIGURATIONS DEBUG)
+set_target_properties(utcf::core PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_DEBUG "CXX"
+  IMPORTED_LOCATION_DEBUG "${_IMPORT_PREFIX}/debug/lib/libutcfd.a"
+  )
+
+list(APPEND _cmake_import_check_targets utcf::core )
+list(APPEND _cmake_import_check_files_for_utcf::core "${_IMPORT_PREFIX}/debug/lib/libutcfd.a" )
+
+# Import target "utcf::tool" for configuration "Debug"
+set_property(TARGET utcf::tool APPEND PROPERTY IMPORTED_CONFIGURATIONS DEBUG)
+set_target_properties(utcf::tool PROPERTIES
+  IMPORTED_LOCATION_DEBUG "${_IMPORT_PREFIX}/tools/utcf/utcf-tool.exe"
+  )
+
+list(APPEND _cmake_import_check_targets utcf::tool )
+list(APPEND _cmake_import_check_files_for_utcf::tool "${_IMPORT_PREFIX}/tools/utcf/utcf-tool.exe" )
+
+# Import target "utcf::plugin" for configuration "Debug"
+set_property(TARGET utcf::plugin APPEND PROPERTY IMPORTED_CONFIGURATIONS DEBUG)
+set_target_properties(utcf::plugin PROPERTIES
+  IMPORTED_IMPLIB_DEBUG "${_IMPORT_PREFIX}/debug/lib/utcf-plugind.lib"
+  IMPORTED_LOCATION_DEBUG "${_IMPORT_PREFIX}/debug/bin/utcf-plugind.dll"
+  IMPORTED_LINK_DEPENDENT_LIBRARIES_DEBUG "${_IMPORT_PREFIX}/debug/lib/libdep.so"
+  )
+
+list(APPEND _cmake_import_check_targets utcf::plugin )
+list(APPEND _cmake_import_check_files_for_utcf::plugin "${_IMPORT_PREFIX}/debug/lib/utcf-plugind.lib" "${_IMPORT_PREFIX}/debug/bin/utcf-plugind.dll" )
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
+set(UTCF_DEBUG_TOOLS "${_IMPORT_PREFIX}/tools/utcf/utcf-tool.exe;${_IMPORT_PREFIX}/tools/utcf/utcf-helper.exe")
+# Inlined from unit-test-config-fixupTargets-release.cmake
+#----------------------------------------------------------------
+# Generated CMake target import file for configuration "Release".
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Import target "utcf::core" for configuration "Release"
+set_property(TARGET utcf::core APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(utcf::core PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_RELEASE "CXX"
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/lib/libutcf.a"
+  )
+
+list(APPEND _cmake_import_check_targets utcf::core )
+list(APPEND _cmake_import_check_files_for_utcf::core "${_IMPORT_PREFIX}/lib/libutcf.a" )
+
+# Import target "utcf::tool" for configuration "Release"
+set_property(TARGET utcf::tool APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(utcf::tool PROPERTIES
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/tools/utcf/utcf-tool.exe"
+  )
+
+list(APPEND _cmake_import_check_targets utcf::tool )
+list(APPEND _cmake_import_check_files_for_utcf::tool "${_IMPORT_PREFIX}/tools/utcf/utcf-tool.exe" )
+
+# Import target "utcf::plugin" for configuration "Release"
+set_property(TARGET utcf::plugin APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(utcf::plugin PROPERTIES
+  IMPORTED_IMPLIB_RELEASE "${_IMPORT_PREFIX}/lib/utcf-plugin.lib"
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/bin/utcf-plugin.dll"
+  IMPORTED_LINK_DEPENDENT_LIBRARIES_RELEASE "${_IMPORT_PREFIX}/lib/libdep.so"
+  )
+
+list(APPEND _cmake_import_check_targets utcf::plugin )
+list(APPEND _cmake_import_check_files_for_utcf::plugin "${_IMPORT_PREFIX}/lib/utcf-plugin.lib" "${_IMPORT_PREFIX}/bin/utcf-plugin.dll" )
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
+
+# Cleanup temporary variables.
+set(_IMPORT_PREFIX)
+set(CMAKE_IMPORT_FILE_VERSION)
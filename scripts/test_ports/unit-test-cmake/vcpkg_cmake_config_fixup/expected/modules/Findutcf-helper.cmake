@@ -0,0 +1,5 @@
+get_filename_component(VCPKG_IMPORT_PREFIX "${CMAKE_CURRENT_LIST_DIR}/../../../" ABSOLUTE)
+find_path(UTCF_HELPER_INCLUDE_DIR NAMES utcf-helper.h PATHS "${VCPKG_IMPORT_PREFIX}/include" NO_DEFAULT_PATH)
+find_library(UTCF_HELPER_LIBRARY NAMES utcf-helper PATHS "${VCPKG_IMPORT_PREFIX}/lib" NO_DEFAULT_PATH)
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(utcf-helper REQUIRED_VARS UTCF_HELPER_LIBRARY UTCF_HELPER_INCLUDE_DIR)
@@ -0,0 +1,40 @@
+#----------------------------------------------------------------
+# Generated CMake target import file for configuration "Debug".
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Import target "utcf::core" for configuration "Debug"
+set_property(TARGET utcf::core APPEND PROPERTY IMPORTED_CONFIGURATIONS DEBUG)
+set_target_properties(utcf::core PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_DEBUG "CXX"
+  IMPORTED_LOCATION_DEBUG "${_IMPORT_PREFIX}/debug/lib/libutcfd.a"
+  )
+
+list(APPEND _cmake_import_check_targets utcf::core )
+list(APPEND _cmake_import_check_files_for_utcf::core "${_IMPORT_PREFIX}/debug/lib/libutcfd.a" )
+
+# Import target "utcf::tool" for configuration "Debug"
+set_property(TARGET utcf::tool APPEND PROPERTY IMPORTED_CONFIGURATIONS DEBUG)
+set_target_properties(utcf::tool PROPERTIES
+  IMPORTED_LOCATION_DEBUG "${_IMPORT_PREFIX}/tools/utcf/utcf-tool.exe"
+  )
+
+list(APPEND _cmake_import_check_targets utcf::tool )
+list(APPEND _cmake_import_check_files_for_utcf::tool "${_IMPORT_PREFIX}/tools/utcf/utcf-tool.exe" )
+
+# Import target "utcf::plugin" for configuration "Debug"
+set_property(TARGET utcf::plugin APPEND PROPERTY IMPORTED_CONFIGURATIONS DEBUG)
+set_target_properties(utcf::plugin PROPERTIES
+  IMPORTED_IMPLIB_DEBUG "${_IMPORT_PREFIX}/debug/lib/utcf-plugind.lib"
+  IMPORTED_LOCATION_DEBUG "${_IMPORT_PREFIX}/debug/bin/utcf-plugind.dll"
+  IMPORTED_LINK_DEPENDENT_LIBRARIES_DEBUG "${_IMPORT_PREFIX}/debug/lib/libdep.so"
+  )
+
+list(APPEND _cmake_import_check_targets utcf::plugin )
+list(APPEND _cmake_import_check_files_for_utcf::plugin "${_IMPORT_PREFIX}/debug/lib/utcf-plugind.lib" "${_IMPORT_PREFIX}/debug/bin/utcf-plugind.dll" )
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
+set(UTCF_DEBUG_TOOLS "${_IMPORT_PREFIX}/tools/utcf/utcf-tool.exe;${_IMPORT_PREFIX}/tools/utcf/utcf-helper.exe")
@@ -0,0 +1,39 @@
+#----------------------------------------------------------------
+# Generated CMake target import file for configuration "Release".
+#----------------------------------------------------------------
+
+# Commands may need to know the format version.
+set(CMAKE_IMPORT_FILE_VERSION 1)
+
+# Import target "utcf::core" for configuration "Release"
+set_property(TARGET utcf::core APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(utcf::core PROPERTIES
+  IMPORTED_LINK_INTERFACE_LANGUAGES_RELEASE "CXX"
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/lib/libutcf.a"
+  )
+
+list(APPEND _cmake_import_check_targets utcf::core )
+list(APPEND _cmake_import_check_files_for_utcf::core "${_IMPORT_PREFIX}/lib/libutcf.a" )
+
+# Import target "utcf::tool" for configuration "Release"
+set_property(TARGET utcf::tool APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(utcf::tool PROPERTIES
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/tools/utcf/utcf-tool.exe"
+  )
+
+list(APPEND _cmake_import_check_targets utcf::tool )
+list(APPEND _cmake_import_check_files_for_utcf::tool "${_IMPORT_PREFIX}/tools/utcf/utcf-tool.exe" )
+
+# Import target "utcf::plugin" for configuration "Release"
+set_property(TARGET utcf::plugin APPEND PROPERTY IMPORTED_CONFIGURATIONS RELEASE)
+set_target_properties(utcf::plugin PROPERTIES
+  IMPORTED_IMPLIB_RELEASE "${_IMPORT_PREFIX}/lib/utcf-plugin.lib"
+  IMPORTED_LOCATION_RELEASE "${_IMPORT_PREFIX}/bin/utcf-plugin.dll"
+  IMPORTED_LINK_DEPENDENT_LIBRARIES_RELEASE "${_IMPORT_PREFIX}/lib/libdep.so"
+  )
+
+list(APPEND _cmake_import_check_targets utcf::plugin )
+list(APPEND _cmake_import_check_files_for_utcf::plugin "${_IMPORT_PREFIX}/lib/utcf-plugin.lib" "${_IMPORT_PREFIX}/bin/utcf-plugin.dll" )
+
+# Commands beyond this point should not need to know the version.
+set(CMAKE_IMPORT_FILE_VERSION)
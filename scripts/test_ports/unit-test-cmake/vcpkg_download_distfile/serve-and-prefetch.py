@@ -0,0 +1,39 @@
+import os
+import sys
+import functools
+import threading
+import subprocess
+
+from http.server import SimpleHTTPRequestHandler, ThreadingHTTPServer
+
+# Serves a fixtures directory on a local port and runs prefetchDistfiles.py --queue against it.
+# @SERVER@ in the queue template is replaced with the address of the server.
+# Usage: serve-and-prefetch.py <prefetchDistfiles.py> <fixtures dir> <queue template> <queue>
+
+
+class QuietHandler(SimpleHTTPRequestHandler):
+    def log_message(self, format, *args):
+        pass
+
+
+def main():
+    prefetch_script, fixtures_dir, queue_template_path, queue_path = sys.argv[1:5]
+    server = ThreadingHTTPServer(('127.0.0.1', 0), functools.partial(QuietHandler, directory=fixtures_dir))
+    server_thread = threading.Thread(target=server.serve_forever, daemon=True)
+    server_thread.start()
+    try:
+        with open(queue_template_path, 'r', encoding='utf-8') as queue_template_file:
+            queue = queue_template_file.read()
+        with open(queue_path, 'w', encoding='utf-8') as queue_file:
+            queue_file.write(queue.replace('@SERVER@', f'127.0.0.1:{server.server_address[1]}'))
+        env = os.environ.copy()
+        env.pop('X_VCPKG_ASSET_SOURCES', None)
+        env['NO_PROXY'] = env['no_proxy'] = '127.0.0.1'
+        return subprocess.run([sys.executable, prefetch_script, '--queue', queue_path, '--no-build'], env=env).returncode
+    finally:
+        server.shutdown()
+        server.server_close()
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -149,6 +149,36 @@ vcpkg_execute_required_process(
     LOGNAME "git-config"
 )
 
+message(STATUS "Testing direct checkout mode")
+set(VCPKG_USE_HEAD_VERSION OFF)
+set(VCPKG_FROM_GIT_DIRECT_CHECKOUT ON)
+foreach(direct_ref IN ITEMS "${ref}" "${head_ref}")
+    # Archives from the previous tests take precedence over the direct checkout.
+    file(REMOVE "${DOWNLOADS}/${PORT}-${direct_ref}.tar.gz")
+    # The second call for each ref checks out from the shared object store without fetching.
+    foreach(attempt RANGE 1)
+        vcpkg_from_git(
+            OUT_SOURCE_PATH source_path
+            URL "${git_remote}"
+            REF "${direct_ref}"
+            FETCH_REF main
+            HEAD_REF main
+        )
+        file(READ "${source_path}/README.txt" contents)
+        if(direct_ref STREQUAL ref)
+            set(expected_contents "first commit")
+        else()
+            set(expected_contents "second commit")
+        endif()
+        if(NOT "${contents}" STREQUAL "${expected_contents}")
+            message(FATAL_ERROR "Failed to check out ${direct_ref} directly. Contents were:
+${contents}
+")
+        endif()
+    endforeach()
+endforeach()
+set(VCPKG_FROM_GIT_DIRECT_CHECKOUT OFF)
+
 message(STATUS "Testing head mode")
 set(VCPKG_USE_HEAD_VERSION ON)
 vcpkg_from_git(
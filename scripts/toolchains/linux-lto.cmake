@@ -0,0 +1,56 @@
+# Link-time optimization for VCPKG_ENABLE_LTO, see scripts/cmake/z_vcpkg_lto.cmake.
+# linux.cmake includes this file as CMAKE_USER_MAKE_RULES_OVERRIDE, because the flags depend on the
+# compiler. It is included for every enabled language, after the compiler has been identified and
+# before the flags are initialized.
+
+foreach(z_vcpkg_lto_lang IN ITEMS C CXX)
+    if(Z_VCPKG_LTO_${z_vcpkg_lto_lang}_DONE OR NOT DEFINED CMAKE_${z_vcpkg_lto_lang}_COMPILER_ID)
+        continue()
+    endif()
+    set(Z_VCPKG_LTO_${z_vcpkg_lto_lang}_DONE 1)
+
+    set(z_vcpkg_lto_link_flags "")
+    if(CMAKE_${z_vcpkg_lto_lang}_COMPILER_ID STREQUAL "GNU")
+        # GCC has no ThinLTO; the parallel WHOPR mode is the closest match.
+        set(z_vcpkg_lto_link_flags "-flto=auto")
+        if(VCPKG_ENABLE_LTO STREQUAL "full")
+            string(APPEND z_vcpkg_lto_link_flags " -flto-partition=one")
+        endif()
+        string(APPEND CMAKE_${z_vcpkg_lto_lang}_FLAGS_RELEASE_INIT " ${z_vcpkg_lto_link_flags} -ffat-lto-objects ")
+    elseif(CMAKE_${z_vcpkg_lto_lang}_COMPILER_ID MATCHES "Clang$")
+        set(z_vcpkg_lto_link_flags "-flto=${VCPKG_ENABLE_LTO}")
+        string(APPEND CMAKE_${z_vcpkg_lto_lang}_FLAGS_RELEASE_INIT " ${z_vcpkg_lto_link_flags} ")
+        if(VCPKG_ENABLE_LTO STREQUAL "thin" AND NOT "${VCPKG_LTO_CACHE_DIR}" STREQUAL "")
+            string(APPEND z_vcpkg_lto_link_flags " -Wl,--plugin-opt=cache-dir=${VCPKG_LTO_CACHE_DIR}")
+        endif()
+    else()
+        continue()
+    endif()
+
+    # The linker flags are shared by all languages and initialized with the first one.
+    if(NOT Z_VCPKG_LTO_LINKER_DONE)
+        set(Z_VCPKG_LTO_LINKER_DONE 1)
+        foreach(z_vcpkg_lto_kind IN ITEMS EXE SHARED MODULE)
+            string(APPEND CMAKE_${z_vcpkg_lto_kind}_LINKER_FLAGS_RELEASE_INIT " ${z_vcpkg_lto_link_flags} ")
+        endforeach()
+        # Static libraries need archivers which index the symbols of LTO objects.
+        if(CMAKE_${z_vcpkg_lto_lang}_COMPILER_AR)
+            set(CMAKE_AR "${CMAKE_${z_vcpkg_lto_lang}_COMPILER_AR}")
+        endif()
+        if(CMAKE_${z_vcpkg_lto_lang}_COMPILER_RANLIB)
+            set(CMAKE_RANLIB "${CMAKE_${z_vcpkg_lto_lang}_COMPILER_RANLIB}")
+        endif()
+        # libtool runs nm on the objects, and only llvm-nm reads LLVM bitcode. It is picked next to
+        # llvm-ar, keeping a version suffix such as llvm-ar-18.
+        if(CMAKE_${z_vcpkg_lto_lang}_COMPILER_ID MATCHES "Clang$" AND CMAKE_AR MATCHES "llvm-ar([^/]*)$")
+            string(REGEX REPLACE "llvm-ar([^/]*)$" "llvm-nm\\1" z_vcpkg_lto_nm "${CMAKE_AR}")
+            if(EXISTS "${z_vcpkg_lto_nm}")
+                set(CMAKE_NM "${z_vcpkg_lto_nm}")
+            endif()
+            unset(z_vcpkg_lto_nm)
+        endif()
+    endif()
+endforeach()
+unset(z_vcpkg_lto_lang)
+unset(z_vcpkg_lto_link_flags)
+unset(z_vcpkg_lto_kind)
@@ -14,7 +14,8 @@ if(NOT _VCPKG_LINUX_TOOLCHAIN)
         cmake_policy(SET CMP0137 NEW)
     endif()
     list(APPEND CMAKE_TRY_COMPILE_PLATFORM_VARIABLES
-        VCPKG_CRT_LINKAGE VCPKG_TARGET_ARCHITECTURE
+        VCPKG_CRT_LINKAGE VCPKG_TARGET_ARCHITECTURE VCPKG_TARGET_ISA_LEVEL
+        VCPKG_ENABLE_LTO VCPKG_LTO_CACHE_DIR
         VCPKG_C_FLAGS VCPKG_CXX_FLAGS
         VCPKG_C_FLAGS_DEBUG VCPKG_CXX_FLAGS_DEBUG
         VCPKG_C_FLAGS_RELEASE VCPKG_CXX_FLAGS_RELEASE
@@ -90,6 +91,24 @@ if(NOT _VCPKG_LINUX_TOOLCHAIN)
         set(CMAKE_CROSSCOMPILING OFF CACHE BOOL "")
     endif()
 
+    if(VCPKG_COMPILER_LAUNCHER)
+        foreach(lang IN ITEMS C CXX)
+            if(NOT DEFINED CMAKE_${lang}_COMPILER_LAUNCHER)
+                set(CMAKE_${lang}_COMPILER_LAUNCHER ${VCPKG_COMPILER_LAUNCHER})
+            endif()
+        endforeach()
+    endif()
+
+    if(VCPKG_TARGET_ISA_LEVEL)
+        foreach(lang IN ITEMS C CXX ASM)
+            string(APPEND CMAKE_${lang}_FLAGS_INIT " -march=${VCPKG_TARGET_ISA_LEVEL} ")
+        endforeach()
+    endif()
+
+    if(VCPKG_ENABLE_LTO AND NOT DEFINED CMAKE_USER_MAKE_RULES_OVERRIDE)
+        set(CMAKE_USER_MAKE_RULES_OVERRIDE "${CMAKE_CURRENT_LIST_DIR}/linux-lto.cmake")
+    endif()
+
     string(APPEND CMAKE_C_FLAGS_INIT " -fPIC ${VCPKG_C_FLAGS} ")
     string(APPEND CMAKE_CXX_FLAGS_INIT " -fPIC ${VCPKG_CXX_FLAGS} ")
     string(APPEND CMAKE_C_FLAGS_DEBUG_INIT " ${VCPKG_C_FLAGS_DEBUG} ")